@@ -0,0 +1,50 @@
+# Generators of modules whose instructions form one long dependency chain, sourced by the benchmarks.
+# usage: chain_module add|gep|select length
+
+chain_add() {
+	awk -v n=$1 'BEGIN {
+		print "define i32 @chain(i32 %x) {"
+		print "  %v0 = add i32 %x, 1"
+		for (i = 1; i <= n; i++) printf "  %%v%d = add i32 %%v%d, %d\n", i, i - 1, i % 7
+		printf "  ret i32 %%v%d\n}\n", n
+	}'
+}
+
+chain_gep() {
+	awk -v n=$1 'BEGIN {
+		print "@buf = global [2 x i8] c\"\\03\\05\""
+		print "define i32 @chain(i32 %x) {"
+		print "  %p0 = getelementptr [2 x i8], [2 x i8]* @buf, i64 0, i64 0"
+		for (i = 1; i <= n; i++) printf "  %%p%d = getelementptr i8, i8* %%p%d, i64 %d\n", i, i - 1, i % 2 ? 1 : -1
+		printf "  %%r = load i8, i8* %%p%d\n", n
+		print "  %z = zext i8 %r to i32"
+		print "  %s = add i32 %z, %x"
+		print "  ret i32 %s\n}"
+	}'
+}
+
+chain_select() {
+	awk -v n=$1 'BEGIN {
+		print "define i32 @chain(i32 %x) {"
+		print "  %s0 = add i32 %x, 0"
+		for (i = 1; i <= n; i++) {
+			printf "  %%c%d = icmp ult i32 %%s%d, 100\n", i, i - 1
+			printf "  %%t%d = add i32 %%s%d, 3\n", i, i - 1
+			printf "  %%s%d = select i1 %%c%d, i32 %%t%d, i32 %%s%d\n", i, i, i, i - 1
+		}
+		printf "  ret i32 %%s%d\n}\n", n
+	}'
+}
+
+chain_main() {
+	echo "define i32 @main(i32 %argc, i8** %argv) {"
+	echo "  %r = call i32 @chain(i32 %argc)"
+	echo "  %m = and i32 %r, 127"
+	echo "  ret i32 %m"
+	echo "}"
+}
+
+chain_module() {
+	chain_$1 $2
+	chain_main
+}
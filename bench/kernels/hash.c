@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define TABLE_BITS 20
+#define TABLE_SIZE (1 << TABLE_BITS)
+#define KEYS (TABLE_SIZE / 2)
+
+static uint64_t keys[TABLE_SIZE];
+static uint32_t values[TABLE_SIZE];
+
+// FNV-1a of the bytes of the key followed by a murmur finalizer
+static uint64_t hash(uint64_t key) {
+	uint64_t h = 14695981039346656037ull;
+	for (int i = 0; i < 8; i++) {
+		h ^= (key >> (i * 8)) & 0xff;
+		h *= 1099511628211ull;
+	}
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	return h;
+}
+
+static void insert(uint64_t key, uint32_t value) {
+	uint64_t i = hash(key) & (TABLE_SIZE - 1);
+	while (keys[i] != 0 && keys[i] != key) {
+		i = (i + 1) & (TABLE_SIZE - 1);
+	}
+	keys[i] = key;
+	values[i] = value;
+}
+
+static uint32_t lookup(uint64_t key) {
+	uint64_t i = hash(key) & (TABLE_SIZE - 1);
+	while (keys[i] != 0) {
+		if (keys[i] == key) {
+			return values[i];
+		}
+		i = (i + 1) & (TABLE_SIZE - 1);
+	}
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 10;
+	uint64_t sum = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < TABLE_SIZE; i++) {
+			keys[i] = 0;
+		}
+		for (uint32_t i = 1; i <= KEYS; i++) {
+			insert(i * 2654435761u + r, i);
+		}
+		// half of the lookups miss
+		for (uint32_t i = 1; i <= 2 * KEYS; i++) {
+			sum += lookup(i * 2654435761u + r);
+		}
+	}
+
+	printf("%llu\n", (unsigned long long) sum);
+	return 0;
+}
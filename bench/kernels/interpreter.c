@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+enum Opcode { PUSH, LOAD, STORE, ADD, SUB, MUL, MOD, LT, JUMP, JUMP_IF_ZERO, HALT };
+
+struct Instruction {
+	enum Opcode op;
+	int arg;
+};
+
+// sum of i * i % 7 for i < n, vars[0] is n, vars[1] is i, vars[2] is the sum
+static const struct Instruction program[] = {
+	{PUSH, 0}, {STORE, 1},
+	{PUSH, 0}, {STORE, 2},
+	{LOAD, 1}, {LOAD, 0}, {LT, 0}, {JUMP_IF_ZERO, 21},
+	{LOAD, 2}, {LOAD, 1}, {LOAD, 1}, {MUL, 0}, {PUSH, 7}, {MOD, 0}, {ADD, 0}, {STORE, 2},
+	{LOAD, 1}, {PUSH, 1}, {ADD, 0}, {STORE, 1},
+	{JUMP, 4},
+	{HALT, 0},
+};
+
+static long run(long n) {
+	long stack[16];
+	long vars[3] = {n, 0, 0};
+	int sp = 0;
+	int pc = 0;
+
+	for (;;) {
+		const struct Instruction* ins = &program[pc++];
+		switch (ins->op) {
+		case PUSH: stack[sp++] = ins->arg; break;
+		case LOAD: stack[sp++] = vars[ins->arg]; break;
+		case STORE: vars[ins->arg] = stack[--sp]; break;
+		case ADD: sp--; stack[sp - 1] += stack[sp]; break;
+		case SUB: sp--; stack[sp - 1] -= stack[sp]; break;
+		case MUL: sp--; stack[sp - 1] *= stack[sp]; break;
+		case MOD: sp--; stack[sp - 1] %= stack[sp]; break;
+		case LT: sp--; stack[sp - 1] = stack[sp - 1] < stack[sp]; break;
+		case JUMP: pc = ins->arg; break;
+		case JUMP_IF_ZERO: if (stack[--sp] == 0) pc = ins->arg; break;
+		case HALT: return vars[2];
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 10;
+	long sum = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		sum += run(3000000 + r);
+	}
+
+	printf("%ld\n", sum);
+	return 0;
+}
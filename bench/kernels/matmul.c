@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 256
+
+static double a[N][N];
+static double b[N][N];
+static double c[N][N];
+
+static void multiply(void) {
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j < N; j++) {
+			c[i][j] = 0;
+		}
+		for (int k = 0; k < N; k++) {
+			double x = a[i][k];
+			for (int j = 0; j < N; j++) {
+				c[i][j] += x * b[k][j];
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 50;
+	double sum = 0;
+
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j < N; j++) {
+			a[i][j] = (i * 7 + j * 3) % 17 / 16.0;
+			b[i][j] = (i * 5 + j * 11) % 13 / 12.0;
+		}
+	}
+
+	for (int r = 0; r < rounds; r++) {
+		multiply();
+		sum += c[r % N][(r * 7) % N];
+		// feed the result back so that the rounds are not independent
+		a[r % N][0] = c[N - 1][r % N] / N;
+	}
+
+	printf("%.6f\n", sum);
+	return 0;
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIZE 1000000
+
+static unsigned seed = 12345;
+
+static unsigned next(void) {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+static void insertion_sort(int* a, int n) {
+	for (int i = 1; i < n; i++) {
+		int x = a[i];
+		int j = i - 1;
+		while (j >= 0 && a[j] > x) {
+			a[j + 1] = a[j];
+			j--;
+		}
+		a[j + 1] = x;
+	}
+}
+
+static void quick_sort(int* a, int n) {
+	while (n > 16) {
+		int pivot = a[n / 2];
+		int i = 0;
+		int j = n - 1;
+		while (i <= j) {
+			while (a[i] < pivot) {
+				i++;
+			}
+			while (a[j] > pivot) {
+				j--;
+			}
+			if (i <= j) {
+				int t = a[i];
+				a[i] = a[j];
+				a[j] = t;
+				i++;
+				j--;
+			}
+		}
+		// recursion into the smaller part only
+		if (j + 1 < n - i) {
+			quick_sort(a, j + 1);
+			a += i;
+			n -= i;
+		} else {
+			quick_sort(a + i, n - i);
+			n = j + 1;
+		}
+	}
+	insertion_sort(a, n);
+}
+
+int main(int argc, char** argv) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 10;
+	int* a = malloc(SIZE * sizeof(int));
+	unsigned long long sum = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < SIZE; i++) {
+			a[i] = (int) (next() % 1000000000);
+		}
+		quick_sort(a, SIZE);
+		for (int i = 0; i < SIZE; i += 1000) {
+			sum = sum * 31 + a[i];
+		}
+	}
+
+	printf("%llu\n", sum);
+	free(a);
+	return 0;
+}
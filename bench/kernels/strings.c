@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEXT_SIZE (1 << 20)
+
+static char text[TEXT_SIZE + 1];
+
+static const char* const WORDS[] = {"lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit"};
+
+static int length(const char* s) {
+	int n = 0;
+	while (s[n]) {
+		n++;
+	}
+	return n;
+}
+
+// naive search, counts overlapping occurrences
+static int count(const char* haystack, const char* needle) {
+	int n = 0;
+	for (const char* p = haystack; *p; p++) {
+		int i = 0;
+		while (needle[i] && p[i] == needle[i]) {
+			i++;
+		}
+		n += needle[i] == '\0';
+	}
+	return n;
+}
+
+// reverses every word in place and upper-cases its first letter
+static void transform(char* s) {
+	while (*s) {
+		while (*s == ' ') {
+			s++;
+		}
+		char* end = s;
+		while (*end && *end != ' ') {
+			end++;
+		}
+		for (char *l = s, *r = end - 1; l < r; l++, r--) {
+			char t = *l;
+			*l = *r;
+			*r = t;
+		}
+		if (*s >= 'a' && *s <= 'z') {
+			*s -= 'a' - 'A';
+		}
+		s = end;
+	}
+}
+
+int main(int argc, char** argv) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 50;
+	unsigned long sum = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		int pos = 0;
+		for (unsigned i = r; pos + 16 < TEXT_SIZE; i = i * 1103515245 + 12345) {
+			const char* word = WORDS[(i >> 16) % 8];
+			int n = length(word);
+			for (int j = 0; j < n; j++) {
+				text[pos++] = word[j];
+			}
+			text[pos++] = ' ';
+		}
+		text[pos] = '\0';
+
+		transform(text);
+		sum += count(text, "Mero") + count(text, "tis") * 3 + length(text);
+	}
+
+	printf("%lu\n", sum);
+	return 0;
+}
@@ -26,7 +26,7 @@
 Block::Block(const std::string &blockName, const llvm::BasicBlock* block, Func* func)
 	: block(block),
 	func(func),
-	blockName(blockName), doInline(false) { }
+	blockName(blockName) { }
 
 void Block::unsetAllInit() {
     /* for (auto expr : expressions) { */
@@ -57,15 +57,33 @@ bool Block::isVoidType(llvm::DITypeRef type) {
 }
 
 void Block::insertValue(const llvm::Value* value, std::unique_ptr<Value> expr) {
-	valueMap[value] = std::move(expr);
+	createTables().valueMap[value] = std::move(expr);
 }
 
 Value* Block::getValue(const llvm::Value* value) {
-	return valueMap[value].get();
+	const auto& valueMap = getTables().valueMap;
+	auto it = valueMap.find(value);
+	return it == valueMap.end() ? nullptr : it->second.get();
 }
 
 void Block::addValue(std::unique_ptr<Value> value) {
-	values.push_back(std::move(value));
+	ownExpr(std::move(value));
+}
+
+void Block::ownExpr(std::unique_ptr<Expr> expr) {
+	func->ownership.push_back(std::move(expr));
+}
+
+const Block::SideTables& Block::getTables() const {
+	static const SideTables empty;
+	return sideTables ? *sideTables : empty;
+}
+
+Block::SideTables& Block::createTables() {
+	if (!sideTables) {
+		sideTables = std::make_unique<SideTables>();
+	}
+	return *sideTables;
 }
 
 void Block::output(std::ostream& stream) {
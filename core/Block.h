@@ -1,6 +1,7 @@
 #pragma once
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Value.h"
@@ -22,41 +23,39 @@ public:
 
     Func* func;
 
-    // TODO move everything owned by the block into this vector
-    std::vector<std::unique_ptr<Expr>> ownership;
-
     // a sequence of expression forming this basic block
     std::vector<Expr*> expressions;
 
-    std::vector<std::unique_ptr<StackAlloc>> allocas;
+    /**
+     * @brief The SideTables struct holds data that only a few blocks need, it is allocated on the first write.
+     */
+    struct SideTables {
+        //alloca expressions
+        llvm::DenseMap<const llvm::Value*, std::unique_ptr<Value>> valueMap; //map of Values used in parsing alloca instruction
 
-    //getelementptr expressions
-    std::vector<std::unique_ptr<GepExpr>> geps; //GepExpr vector used in getelementptr parsing
-    std::vector<std::unique_ptr<Expr>> casts; //Vector of casted values used in parsing getelementptr and store instruction
+        // stacksave and stackrestore calls written as braces of a scope
+        llvm::DenseSet<const llvm::Instruction*> stackScopes;
 
-    //store expressions
-    std::map<Expr*, std::unique_ptr<Expr>> derefs; //Map used for storing unique pointers to DerefExpr (used in store instruction parsing)
+        // dynamic allocas freed no earlier than at the end of their C scope, written as variable-length arrays
+        llvm::DenseSet<const llvm::Instruction*> arrayAllocas;
 
-    //alloca expressions
-    llvm::DenseMap<const llvm::Value*, std::unique_ptr<Value>> valueMap; //map of Values used in parsing alloca instruction
+        // pragmas written before the loop starting in this block, from its !llvm.loop metadata
+        std::vector<std::string> loopPragmas;
+    };
 
-    //extractvalue expressions
-    std::vector<std::unique_ptr<Value>> values; //Vector of Values used in parsing extractvalue
+    std::unique_ptr<SideTables> sideTables;
 
-    //inline asm and load expressions
-    std::vector<std::unique_ptr<Expr>> vars; //Vector of Values used in parsing inline asm and load
-    std::vector<std::unique_ptr<Expr>> stores; //Vector of EqualsExpr used in parsing inline asm and load
-    std::vector<std::unique_ptr<Expr>> loadDerefs; //Vector of DerefExpr used in parsing load
+    // the block is the header of a loop, the loop spans the block and its followers
+    bool isLoopHeader = false;
 
-    //call expressions
-    std::vector<std::unique_ptr<Expr>> callExprMap; //Vector of CallExpr used in parsing call instruction
-    std::vector<std::unique_ptr<Expr>> callValueMap; //Vector of EqualsExpr used in parsing call instruction
+    // some branch reaches the block by goto, so it needs a label
+    bool hasLabel = false;
 
-    // assignments of values to variables for phi nodes
-    std::vector<std::unique_ptr<Expr>> phiAssignments;
+    // blocks dominated by this one, written right after it (inside of its loop)
+    std::vector<Block*> followers;
 
-    // instead of `goto block`, the block will be outputed in place
-    bool doInline;
+    // blocks written right after the loop starting in this block
+    std::vector<Block*> loopExits;
 
     /**
      * @brief createConstantValue Creates Value for given ConstantInt or ConstantFP and inserts it into exprMap.
@@ -117,11 +116,6 @@ public:
      */
     void unsetAllInit();
 
-    /**
-     * @brief addPhiAssignment Adds assignment @expr to the end of block (just before the last br)
-     */
-    void addPhiAssignment(std::unique_ptr<Expr> expr);
-
 public:
     std::string blockName;
 
@@ -148,4 +142,28 @@ public:
     Value* getValue(const llvm::Value* value);
 
     void addValue(std::unique_ptr<Value> value);
+
+    /**
+     * @brief own Moves the expression into the store of the function, which owns expressions of all its blocks.
+     * @param expr Expression created while parsing the block
+     * @return Pointer to the expression
+     */
+    template<typename T>
+    T* own(std::unique_ptr<T> expr) {
+        T* result = expr.get();
+        ownExpr(std::move(expr));
+        return result;
+    }
+
+    void ownExpr(std::unique_ptr<Expr> expr);
+
+    /**
+     * @brief getTables Returns the side tables of the block, empty ones if the block has none. Never allocates.
+     */
+    const SideTables& getTables() const;
+
+    /**
+     * @brief createTables Returns the side tables of the block for writing, they are allocated on the first call.
+     */
+    SideTables& createTables();
 };
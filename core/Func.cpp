@@ -2,10 +2,12 @@
 
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Metadata.h>
+#include <llvm/IR/Operator.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include "../type/Type.h"
 #include "../parser/cfunc.h"
+#include "../parser/constval.h"
 
 #include <utility>
 #include <cstdint>
@@ -14,29 +16,78 @@
 #include <set>
 #include <regex>
 
-Func::Func(const llvm::Function* func, Program* program, bool isDeclaration) {
-	this->program = program;
-	function = func;
-	this->isDeclaration = isDeclaration;
-	returnType = getType(func->getReturnType());
+Func::Func(const llvm::Function* func, Program* program)
+	: FuncDecl(func, program->getType(func->getReturnType())),
+	program(program) {
+	//arguments are numbered by their position, instructions in the order of the function
+	unsigned count = func->arg_size();
+	for (const auto& block : *func) {
+		count += block.size();
+	}
+	instructionNumbers.reserve(count - func->arg_size());
+
+	unsigned number = func->arg_size();
+	for (const auto& block : *func) {
+		for (const auto& ins : block) {
+			instructionNumbers[&ins] = number++;
+		}
+	}
+	exprTable.resize(count);
+}
+
+std::unique_ptr<Expr>* Func::getExprSlot(const llvm::Value* val) {
+	if (auto arg = llvm::dyn_cast<llvm::Argument>(val)) {
+		if (arg->getParent() == function) {
+			return &exprTable[arg->getArgNo()];
+		}
+	} else if (auto ins = llvm::dyn_cast<llvm::Instruction>(val)) {
+		auto it = instructionNumbers.find(ins);
+		if (it != instructionNumbers.end()) {
+			return &exprTable[it->second];
+		}
+	}
+
+	auto it = exprMap.find(val);
+	if (it != exprMap.end()) {
+		return &it->second;
+	}
+	return nullptr;
 }
 
 Expr* Func::getExpr(const llvm::Value* val) {
-    auto it = exprMap.find(val);
-	if (it == exprMap.end()) {
-		if (auto F = llvm::dyn_cast<llvm::Function>(val)) {
-			createExpr(val, std::make_unique<Value>("&" + F->getName().str(), getType(F->getReturnType())));
-			return exprMap.find(val)->second.get();
+	if (auto slot = getExprSlot(val)) {
+		if (*slot) {
+			return slot->get();
 		}
-	} else {
-		return it->second.get();
+	}
+
+	if (auto constant = program->getConstant(val, this)) {
+		return constant;
 	}
 
 	return program->getGlobalVar(val);
 }
 
+Expr* Func::getOrCreateExpr(const llvm::Value* val, Block* block) {
+	if (Expr* expr = getExpr(val)) {
+		return expr;
+	}
+
+	createConstantValue(val, this, block);
+	return getExpr(val);
+}
+
 void Func::createExpr(const llvm::Value* val, std::unique_ptr<Expr> expr) {
-	exprMap[val] = std::move(expr);
+	if (auto slot = getExprSlot(val)) {
+		*slot = std::move(expr);
+	} else {
+		exprMap[val] = std::move(expr);
+	}
+}
+
+std::unique_ptr<Expr> Func::releaseExpr(const llvm::Value* val) {
+	auto slot = getExprSlot(val);
+	return slot ? std::move(*slot) : nullptr;
 }
 
 std::string Func::getVarName() {
@@ -74,8 +125,28 @@ std::unique_ptr<Type> Func::getType(const llvm::Type* type) {
 	return program->getType(type);
 }
 
+//phi is incremented by an operation without signed overflow, e.g. induction variable i = add nsw i, 1
+static bool hasSignedIncrement(const llvm::PHINode* phi) {
+	for (const auto& incoming : phi->incoming_values()) {
+		auto op = llvm::dyn_cast<llvm::OverflowingBinaryOperator>(incoming.get());
+		if (op && op->hasNoSignedWrap() && (op->getOperand(0) == phi || op->getOperand(1) == phi)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void Func::createPhiVariable(const llvm::Value* phi) {
-	auto var = std::make_unique<Value>(getVarName() + "_phi", getType(phi->getType()));
+	auto type = getType(phi->getType());
+
+	//signed variable lets the C compiler assume that it does not overflow, as LLVM does
+	auto IT = dynamic_cast<IntegerType*>(type.get());
+	if (IT && !phi->getType()->isIntegerTy(1) && hasSignedIncrement(llvm::cast<llvm::PHINode>(phi))) {
+		IT->unsignedType = false;
+	}
+
+	auto var = std::make_unique<Value>(getVarName() + "_phi", std::move(type));
 	phiVariables.push_back(var.get());
 
 	createExpr(phi, std::move(var));
@@ -109,10 +180,6 @@ Block* Func::getBlock(const llvm::BasicBlock* block) {
 	return iter->second.get();
 }
 
-void Func::setVarArg(bool va) {
-	isVarArg = va;
-}
-
 void Func::addMetadataVarName(const std::string& varName) {
 	metadataVarNames.insert(varName);
 }
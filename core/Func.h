@@ -12,12 +12,13 @@ class Program;
 #include "../expr/UnaryExpr.h"
 #include "../expr/BinaryExpr.h"
 #include "Block.h"
+#include "FuncDecl.h"
 #include "Program.h"
 
 /**
- * @brief The Func class represents one of the functions of the LLVM program.
+ * @brief The Func class represents one of the functions defined in the LLVM program.
  */
-class Func {
+class Func : public FuncDecl {
 friend class Block;
 friend class Program;
 
@@ -30,17 +31,14 @@ struct PhiEntry {
     PhiEntry(const llvm::Value* phi, const llvm::BasicBlock *inBlock, const llvm::Value *inValue) : phi(phi), inBlock(inBlock), inValue(inValue) {}
 };
 
-    std::unique_ptr<Type> returnType;
-
-    const llvm::Function* function;
     Program* program;
 
     std::map<const llvm::BasicBlock*, std::unique_ptr<Block>> blockMap; //DenseMap used for mapping llvm::BasicBlock to Block
-    llvm::DenseMap<const llvm::Value*, std::unique_ptr<Expr>> exprMap; // DenseMap used for mapping llvm::Value to Expr
-
-    std::string name;
-
-    std::vector<Value*> parameters;
+    Block* entryBlock = nullptr; //first block of the function, all reachable blocks are written from it
+    llvm::DenseMap<const llvm::Instruction*, unsigned> instructionNumbers; //dense numbers of instructions, they follow the numbers of arguments
+    std::vector<std::unique_ptr<Expr>> exprTable; //expressions of arguments and instructions indexed by their numbers
+    llvm::DenseMap<const llvm::Value*, std::unique_ptr<Expr>> exprMap; //expressions of values that are not numbered, e.g. block addresses
+    std::vector<std::unique_ptr<Expr>> ownership; //expressions created while parsing the blocks, blocks only point to them
 
     //set containing metadata names of variables (and names of global variables) that are in "var[0-9]+" format, used in creating variable names
     std::set<std::string> metadataVarNames;
@@ -48,19 +46,20 @@ struct PhiEntry {
     // phi entries of all blocks in this function
     std::vector<PhiEntry> phiEntries;
 
-    // variables that correspond to phi nodes and will be declared at the beginning of the function
+    // variables that correspond to phi nodes, declared in the scope of their uses by scopeVariables
     std::vector<Value*> phiVariables;
 
     //variables used for creating names for variables and blocks
     unsigned varCount = 0;
     unsigned blockCount = 0;
 
-
-    bool isDeclaration; //function is only being declared
-    bool isVarArg = false; //function has variable number of arguments
+    //number of statements at the start of the entry block assigning temporaries of nested constant expressions
+    unsigned constantTemporaries = 0;
 
     Expr* lastArg; //last argument before variable arguments
 
+    std::vector<std::unique_ptr<GlobalValue>> staticVars; //global variables defined in the function, e.g. tables of block addresses
+
 
     /**
      * @brief createNewUnnamedStruct
@@ -73,6 +72,13 @@ struct PhiEntry {
      */
     void getMetadataNames();
 
+    /**
+     * @brief getExprSlot Returns the slot holding Expr of val, in exprTable if val is an argument or instruction of the function.
+     * @param val Key of the Expr
+     * @return Pointer to the slot if val is numbered or already in exprMap, nullptr otherwise
+     */
+    std::unique_ptr<Expr>* getExprSlot(const llvm::Value* val);
+
 public:
     /**
      * @brief getBlockName Returns name of the block if the block already has an assigned name.
@@ -87,9 +93,8 @@ public:
      * @brief Func Constructor for Func.
      * @param func llvm::Function for parsing
      * @param program Program to which function belongs
-     * @param isDeclaration function is only being declared
      */
-    Func(const llvm::Function* func, Program* program, bool isDeclaration);
+    Func(const llvm::Function* func, Program* program);
 
     /**
      * @brief getStruct Returns pointer to the Struct corresponding to the given LLVM StructType.
@@ -131,19 +136,34 @@ public:
     Block* createBlockIfNotExist(const llvm::BasicBlock* block);
 
     /**
-     * @brief getExpr Finds Expr in exprMap or globalRefs with key val. If val is function, creates Value containing refference to the function and returns pointer to this Value.
+     * @brief getExpr Finds Expr in exprTable, exprMap, the constant pool of the program or globalRefs with key val. If val is function, creates Value containing refference to the function and returns pointer to this Value.
      * @param val Key of the Expr
      * @return Pointer to the Expr if val is found, nullptr otherwise.
      */
     Expr* getExpr(const llvm::Value* val);
 
     /**
-     * @brief createExpr Inserts expr into the exprMap using val as a key.
+     * @brief getOrCreateExpr Finds Expr for the operand val like getExpr. If there is none, val is a constant and its Expr is created first.
+     * @param val Operand of an instruction
+     * @param block Block containing the instruction, constant expressions may add their statements into it
+     * @return Pointer to the Expr of val.
+     */
+    Expr* getOrCreateExpr(const llvm::Value* val, Block* block);
+
+    /**
+     * @brief createExpr Maps val to expr, arguments and instructions are stored in exprTable, other values in exprMap.
      * @param val Key
      * @param expr Mapped Value
      */
     void createExpr(const llvm::Value* val, std::unique_ptr<Expr> expr);
 
+    /**
+     * @brief releaseExpr Takes the ownership of Expr of val, val stays mapped to nothing until createExpr is called again.
+     * @param val Key of the Expr
+     * @return unique_ptr to the Expr, nullptr if val has none
+     */
+    std::unique_ptr<Expr> releaseExpr(const llvm::Value* val);
+
     /**
      * @brief getBlock Obtains a block from this function that corresponds to the specified LLVM block
      * @param block LLVM basic block
@@ -157,8 +177,6 @@ public:
      */
     std::string getVarName();
 
-    void setVarArg(bool va);
-
     template< typename T >
     void fillMetadataVarNames(const T& globalVarNames) {
         metadataVarNames.insert(globalVarNames.begin(), globalVarNames.end());
@@ -0,0 +1,16 @@
+#include "FuncDecl.h"
+
+#include "../type/Type.h"
+
+FuncDecl::FuncDecl(const llvm::Function* func, std::unique_ptr<Type> returnType)
+	: returnType(std::move(returnType)),
+	function(func) { }
+
+void FuncDecl::addParameter(std::unique_ptr<Value> param) {
+	parameters.push_back(param.get());
+	ownedParameters.push_back(std::move(param));
+}
+
+void FuncDecl::setVarArg(bool va) {
+	isVarArg = va;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <memory>
+
+#include "llvm/IR/Function.h"
+
+#include "../expr/Expr.h"
+
+/**
+ * @brief The FuncDecl class represents the head of a function: its name, return type, parameters and attributes.
+ * Declarations are written only from it, a Func extends it with the body of a defined function.
+ */
+class FuncDecl {
+public:
+    std::unique_ptr<Type> returnType;
+
+    const llvm::Function* function;
+
+    std::string name;
+
+    std::vector<Value*> parameters;
+
+    bool isVarArg = false; //function has variable number of arguments
+
+    std::vector<std::string> attributes; //GCC attributes of the function, e.g. "noinline" or "nonnull(1)"
+    std::set<const Value*> restrictParams; //pointer parameters declared with restrict
+    std::map<const Value*, unsigned> alignedParams; //parameters assumed to be aligned at the start of the function body
+
+    /**
+     * @brief FuncDecl Constructor for FuncDecl.
+     * @param func llvm::Function being declared
+     * @param returnType Return type of the function
+     */
+    FuncDecl(const llvm::Function* func, std::unique_ptr<Type> returnType);
+
+    /**
+     * @brief addParameter Appends a parameter owned by the declaration. Parameters of a Func are owned by its exprTable instead.
+     * @param param Value of the parameter
+     */
+    void addParameter(std::unique_ptr<Value> param);
+
+    void setVarArg(bool va);
+
+private:
+    std::vector<std::unique_ptr<Value>> ownedParameters;
+};
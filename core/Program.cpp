@@ -74,7 +74,45 @@ RefExpr* Program::getGlobalVar(const llvm::Value* val) {
 	return nullptr;
 }
 
-void Program::addDeclaration(const llvm::Function* func, std::unique_ptr<Func> decl) {
+Value* Program::getConstant(const llvm::Value* val, const Func* user) {
+	auto it = constants.find(val);
+	if (it == constants.end()) {
+		const llvm::Function* F = llvm::dyn_cast<llvm::Function>(val);
+		if (!F) {
+			return nullptr;
+		}
+
+		addConstant(val, std::make_unique<Value>("&" + F->getName().str(), getType(F->getReturnType())), user);
+		return constants.find(val)->second.value.get();
+	}
+
+	//without the pool, every function using the constant would have its own copy
+	if (it->second.lastUser != user) {
+		it->second.lastUser = user;
+		constantCopies++;
+	}
+
+	return it->second.value.get();
+}
+
+void Program::addConstant(const llvm::Value* val, std::unique_ptr<Value> value, const Func* user) {
+	constants[val] = PooledConstant{std::move(value), user};
+	constantCopies++;
+}
+
+void Program::printConstantPoolStats(std::ostream& stream) const {
+	//types of the values are not counted, so the saving is a lower bound
+	size_t bytes = 0;
+	for (const auto& entry : constants) {
+		bytes += sizeof(Value) + entry.second.value->valueName.capacity() - std::string().capacity();
+	}
+
+	size_t saved = constants.empty() ? 0 : (constantCopies - constants.size()) * (bytes / constants.size());
+	stream << "constant pool: " << constants.size() << " values shared instead of " << constantCopies
+		<< " copies in functions, at least " << saved / 1024 << " kB saved\n";
+}
+
+void Program::addDeclaration(const llvm::Function* func, std::unique_ptr<FuncDecl> decl) {
 	if (!isFunctionDeclared(func)) {
 		declarations[func] = std::move(decl);
 	}
@@ -292,7 +330,7 @@ void Program::outputStruct(Struct* strct, std::ostream& stream) {
 	/* } */
 }
 
-Func* Program::getDeclaration(const llvm::Function* func) {
+FuncDecl* Program::getDeclaration(const llvm::Function* func) {
     auto it = declarations.find(func);
     if (it == declarations.end()) {
         return nullptr;
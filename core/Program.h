@@ -27,12 +27,23 @@ public:
 
     //expressions
     llvm::DenseMap<const llvm::Function*, std::unique_ptr<Func>> functions; //map containing function definitions
-    llvm::DenseMap<const llvm::Function*, std::unique_ptr<Func>> declarations; //map containing function declarations
+    llvm::DenseMap<const llvm::Function*, std::unique_ptr<FuncDecl>> declarations; //map containing function declarations
     std::vector<std::unique_ptr<Struct>> structs; // vector of parsed structs
     std::vector<std::unique_ptr<GlobalValue>> globalVars; // vector of parsed global variables
     llvm::DenseMap<const llvm::GlobalVariable*, std::unique_ptr<RefExpr>> globalRefs; //map containing references to global variables
     llvm::DenseMap<const llvm::StructType*, std::unique_ptr<Struct>> unnamedStructs; // map containing unnamed structs
 
+    /**
+     * @brief The PooledConstant struct is an entry of the constant pool, the value is formatted once and shared by all functions.
+     */
+    struct PooledConstant {
+        std::unique_ptr<Value> value;
+        const Func* lastUser = nullptr; //function that used the value last, functions are translated one after another
+    };
+
+    llvm::DenseMap<const llvm::Value*, PooledConstant> constants; //map containing values of constants and references to functions
+    unsigned constantCopies = 0; //number of values that functions would own without the pool
+
     //set containing names of global variables that are in "var[0-9]+" format, used in creating variable names in functions
     std::set<std::string> globalVarNames;
 
@@ -102,6 +113,8 @@ public:
     bool hasStdio = false; //program uses "stdio.h"
     bool hasPthread = false; //program uses "pthread.h"
 
+    bool hasMustTail = false; //program contains calls that must be compiled as tail calls
+
     bool includes; //program uses includes instead of declarations for standard library functions, for testing purposes only
     bool noFuncCasts; //program removes any function call casts, for testing purposes only
 
@@ -135,6 +148,28 @@ public:
      */
     RefExpr* getGlobalVar(const llvm::Value* val);
 
+    /**
+     * @brief getConstant Returns Value of the constant from the constant pool. References to functions are created on demand.
+     * @param val llvm constant
+     * @param user Function using the constant
+     * @return Value or nullptr if the constant is not in the pool
+     */
+    Value* getConstant(const llvm::Value* val, const Func* user);
+
+    /**
+     * @brief addConstant Adds Value of the constant into the constant pool.
+     * @param val llvm constant
+     * @param value Value of the constant, it must not be changed after it is added
+     * @param user Function using the constant
+     */
+    void addConstant(const llvm::Value* val, std::unique_ptr<Value> value, const Func* user);
+
+    /**
+     * @brief printConstantPoolStats Prints the size of the constant pool and the number of values it saves.
+     * @param stream Stream for output
+     */
+    void printConstantPoolStats(std::ostream& stream) const;
+
     /**
      * @brief getFunction Returns corresponding function to LLVM function.
      * @param f llvm function pointer
@@ -146,7 +181,7 @@ public:
      * @brief addDeclaration Adds new declaration of given function.
      * @param func LLVM Function
      */
-    void addDeclaration(const llvm::Function* func, std::unique_ptr<Func> decl);
+    void addDeclaration(const llvm::Function* func, std::unique_ptr<FuncDecl> decl);
 
     /**
      * @brief getType Transforms llvm::Type into corresponding Type object
@@ -171,5 +206,5 @@ public:
 
     const std::set<std::string>& getGlobalVarNames() const;
 
-    Func* getDeclaration(const llvm::Function* func);
+    FuncDecl* getDeclaration(const llvm::Function* func);
 };
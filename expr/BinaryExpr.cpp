@@ -8,7 +8,8 @@
  * BinaryExpr classes
  */
 
-BinaryExpr::BinaryExpr(Expr* l, Expr* r) {
+BinaryExpr::BinaryExpr(ExprKind kind, Expr* l, Expr* r)
+    : ExprBase(kind) {
     left = l;
     right = r;
 
@@ -16,70 +17,70 @@ BinaryExpr::BinaryExpr(Expr* l, Expr* r) {
 }
 
 AddExpr::AddExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::AddExpr, l, r), isUnsigned(isUnsigned) { }
 
 void AddExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 SubExpr::SubExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::SubExpr, l, r), isUnsigned(isUnsigned) { }
 
 void SubExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 AssignExpr::AssignExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(ExprKind::AssignExpr, l, r) { }
 
 void AssignExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 MulExpr::MulExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::MulExpr, l, r), isUnsigned(isUnsigned) { }
 
 void MulExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 DivExpr::DivExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::DivExpr, l, r), isUnsigned(isUnsigned) { }
 
 void DivExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 RemExpr::RemExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::RemExpr, l, r), isUnsigned(isUnsigned) { }
 
 void RemExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 AndExpr::AndExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(ExprKind::AndExpr, l, r) { }
 
 void AndExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 OrExpr::OrExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(ExprKind::OrExpr, l, r) { }
 
 void OrExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 XorExpr::XorExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(ExprKind::XorExpr, l, r) { }
 
 void XorExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 CmpExpr::CmpExpr(Expr* l, Expr* r, const std::string& cmp, bool isUnsigned) :
-    BinaryExpr(l,r) {
+    BinaryExpr(ExprKind::CmpExpr, l,r) {
     comparsion = cmp;
     this->isUnsigned = isUnsigned;
     setType(std::make_unique<IntType>(false));
@@ -90,21 +91,21 @@ void CmpExpr::accept(ExprVisitor& visitor) {
 }
 
 AshrExpr::AshrExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::AshrExpr, l, r), isUnsigned(isUnsigned) { }
 
 void AshrExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 LshrExpr::LshrExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::LshrExpr, l, r), isUnsigned(isUnsigned) { }
 
 void LshrExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 ShlExpr::ShlExpr(Expr* l, Expr* r, bool isUnsigned) :
-    BinaryExpr(l, r), isUnsigned(isUnsigned) { }
+    BinaryExpr(ExprKind::ShlExpr, l, r), isUnsigned(isUnsigned) { }
 
 void ShlExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
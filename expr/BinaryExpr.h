@@ -12,7 +12,7 @@ public:
     Expr* left; //first operand of binary operation
     Expr* right; //second operand of binary operation
 
-    BinaryExpr(Expr*, Expr*);
+    BinaryExpr(ExprKind, Expr*, Expr*);
 };
 
 /**
@@ -3,8 +3,12 @@
 
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <set>
+
 Struct::Struct(const std::string& name)
-    : name(name) {
+    : ExprBase(ExprKind::Struct),
+      name(name) {
     setType(std::make_unique<StructType>(this->name));
 }
 
@@ -17,7 +21,8 @@ void Struct::accept(ExprVisitor& visitor) {
 }
 
 StructElement::StructElement(Struct* strct, Expr* expr, unsigned element)
-    : strct(strct),
+    : ExprBase(ExprKind::StructElement),
+      strct(strct),
       expr(expr),
       element(element) {
     setType(strct->items[element].first->clone());
@@ -28,14 +33,16 @@ void StructElement::accept(ExprVisitor& visitor) {
 }
 
 ArrayElement::ArrayElement(Expr* expr, Expr* elem)
-    : expr(expr),
+    : ExprBase(ExprKind::ArrayElement),
+      expr(expr),
       element(elem) {
     ArrayType* AT = static_cast<ArrayType*>(expr->getType());
     setType(AT->type->clone());
 }
 
 ArrayElement::ArrayElement(Expr* expr, Expr* elem, std::unique_ptr<Type> type)
-    : expr(expr),
+    : ExprBase(ExprKind::ArrayElement),
+      expr(expr),
       element(elem) {
     setType(std::move(type));
 }
@@ -44,7 +51,8 @@ void ArrayElement::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
-ExtractValueExpr::ExtractValueExpr(std::vector<std::unique_ptr<Expr>>& indices) {
+ExtractValueExpr::ExtractValueExpr(std::vector<std::unique_ptr<Expr>>& indices)
+    : ExprBase(ExprKind::ExtractValueExpr) {
     for (auto& idx : indices) {
         this->indices.push_back(std::move(idx));
     }
@@ -56,7 +64,11 @@ void ExtractValueExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
-Value::Value(const std::string& valueName, std::unique_ptr<Type> type) {
+Value::Value(const std::string& valueName, std::unique_ptr<Type> type)
+    : Value(ExprKind::Value, valueName, std::move(type)) { }
+
+Value::Value(ExprKind kind, const std::string& valueName, std::unique_ptr<Type> type)
+    : ExprBase(kind) {
     setType(std::move(type));
     this->valueName = valueName;
 }
@@ -74,7 +86,7 @@ bool Value::isSimple() const {
 }
 
 GlobalValue::GlobalValue(const std::string& varName, const std::string& value, std::unique_ptr<Type> type)
-    : Value(varName, std::move(type)),
+    : Value(ExprKind::GlobalValue, varName, std::move(type)),
       value(value) { }
 
 void GlobalValue::accept(ExprVisitor& visitor) {
@@ -86,12 +98,22 @@ bool GlobalValue::isSimple() const {
 }
 
 IfExpr::IfExpr(Expr* cmp, Block* trueBlock, Block* falseBlock)
-    : cmp(cmp),
+    : ExprBase(ExprKind::IfExpr),
+      cmp(cmp),
       trueBlock(trueBlock),
       falseBlock(falseBlock) {}
 
+ScopeExpr::ScopeExpr(bool isOpening)
+    : ExprBase(ExprKind::ScopeExpr),
+      isOpening(isOpening) {}
+
+void ScopeExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
+
 IfExpr::IfExpr(Block* trueBlock)
-    : cmp(nullptr),
+    : ExprBase(ExprKind::IfExpr),
+      cmp(nullptr),
       trueBlock(trueBlock),
       falseBlock(nullptr) {}
 
@@ -99,17 +121,36 @@ void IfExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
-SwitchExpr::SwitchExpr(Expr* cmp, Block* def, std::map<int, Block*> cases)
-    : cmp(cmp),
+SwitchExpr::SwitchExpr(Expr* cmp, Block* def, std::vector<std::pair<int64_t, Block*>> cases, unsigned bitWidth)
+    : ExprBase(ExprKind::SwitchExpr),
+      cmp(cmp),
       def(def),
-      cases(cases) {}
+      cases(std::move(cases)),
+      bitWidth(bitWidth) {}
+
+std::vector<Block*> SwitchExpr::targets() const {
+    std::vector<Block*> result;
+    std::set<const Block*> seen;
+    for (const auto& lb_block : cases) {
+        if (seen.insert(lb_block.second).second) {
+            result.push_back(lb_block.second);
+        }
+    }
+
+    if (def && seen.insert(def).second) {
+        result.push_back(def);
+    }
+
+    return result;
+}
 
 void SwitchExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
 AsmExpr::AsmExpr(const std::string& inst, const std::vector<std::pair<std::string, Expr*>>& output, const std::vector<std::pair<std::string, Expr*>>& input, const std::string& clobbers)
-    : inst(inst),
+    : ExprBase(ExprKind::AsmExpr),
+      inst(inst),
       output(output),
       input(input),
       clobbers(clobbers) {}
@@ -128,7 +169,8 @@ void AsmExpr::accept(ExprVisitor& visitor) {
 }
 
 CallExpr::CallExpr(Expr* funcValue, const std::string &funcName, std::vector<Expr*> params, std::unique_ptr<Type> type)
-    : funcName(funcName),
+    : ExprBase(ExprKind::CallExpr),
+      funcName(funcName),
       params(params),
       funcValue(funcValue) {
     setType(std::move(type));
@@ -139,7 +181,8 @@ void CallExpr::accept(ExprVisitor& visitor) {
 }
 
 PointerShift::PointerShift(std::unique_ptr<Type> ptrType, Expr* pointer, Expr* move)
-    : ptrType(std::move(ptrType)),
+    : ExprBase(ExprKind::PointerShift),
+      ptrType(std::move(ptrType)),
       pointer(pointer),
       move(move) {
     if (auto PT = dynamic_cast<PointerType*>(this->ptrType.get())) {
@@ -151,7 +194,8 @@ void PointerShift::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
-GepExpr::GepExpr(std::vector<std::unique_ptr<Expr>>& indices) {
+GepExpr::GepExpr(std::vector<std::unique_ptr<Expr>>& indices)
+    : ExprBase(ExprKind::GepExpr) {
     for (auto& index : indices) {
         this->indices.push_back(std::move(index));
     }
@@ -164,6 +208,7 @@ void GepExpr::accept(ExprVisitor& visitor) {
 }
 
 SelectExpr::SelectExpr(Expr* comp, Expr* l, Expr* r) :
+    ExprBase(ExprKind::SelectExpr),
     left(l),
     right(r),
     comp(comp) {
@@ -174,7 +219,60 @@ void SelectExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
-StackAlloc::StackAlloc(Value* var): value(var) {
+InsertElementExpr::InsertElementExpr(Expr* vector, Expr* element, Expr* index) :
+    ExprBase(ExprKind::InsertElementExpr),
+    vector(vector),
+    element(element),
+    index(index) {
+    setType(vector->getType()->clone());
+}
+
+void InsertElementExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
+
+ShuffleVectorExpr::ShuffleVectorExpr(Expr* l, Expr* r, const std::vector<int>& mask, std::unique_ptr<Type> type) :
+    ExprBase(ExprKind::ShuffleVectorExpr),
+    left(l),
+    right(r),
+    mask(mask) {
+    setType(std::move(type));
+}
+
+void ShuffleVectorExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
+
+AtomicRMWExpr::AtomicRMWExpr(Expr* pointer, Expr* value, Op op, const std::string& order, std::unique_ptr<Type> type) :
+    ExprBase(ExprKind::AtomicRMWExpr),
+    pointer(pointer),
+    value(value),
+    op(op),
+    order(order) {
+    setType(std::move(type));
+}
+
+void AtomicRMWExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
+
+VectorReduceExpr::VectorReduceExpr(Expr* vector, Expr* start, unsigned size, const std::string& op, const std::string& builtin, std::unique_ptr<Type> type) :
+    ExprBase(ExprKind::VectorReduceExpr),
+    vector(vector),
+    start(start),
+    size(size),
+    op(op),
+    builtin(builtin) {
+    setType(std::move(type));
+}
+
+void VectorReduceExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
+
+StackAlloc::StackAlloc(Value* var)
+    : ExprBase(ExprKind::StackAlloc),
+      value(var) {
     setType(var->getType()->clone());
 }
 
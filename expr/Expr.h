@@ -17,6 +17,10 @@ class Block;
  */
 class Expr {
 public:
+    const ExprKind kind; //class of the expression, used by StaticExprVisitor instead of accept
+
+    Expr(ExprKind kind) : kind(kind) { }
+
     virtual ~Expr() = default;
     virtual void accept(ExprVisitor& visitor) = 0;
     virtual const Type* getType() const = 0;
@@ -34,6 +38,8 @@ private:
     std::unique_ptr<Type> type;
 
 public:
+    ExprBase(ExprKind kind) : Expr(kind) { }
+
     const Type* getType() const override {
         return type.get();
     }
@@ -129,6 +135,9 @@ public:
     bool isZero() const override;
 
     bool isSimple() const override;
+
+protected:
+    Value(ExprKind, const std::string&, std::unique_ptr<Type>);
 };
 
 /**
@@ -137,6 +146,7 @@ public:
 class GlobalValue : public Value {
 public:
     std::string value;
+    unsigned alignment = 0; //alignment higher than the natural one of the type, 0 otherwise
 
     GlobalValue(const std::string&, const std::string&, std::unique_ptr<Type>);
 
@@ -147,6 +157,29 @@ public:
     bool isSimple() const override;
 };
 
+/**
+ * @brief The JumpKind enum describes how a branch to a block is written.
+ */
+enum class JumpKind {
+    GOTO, //goto block
+    INLINE, //the block is written in place
+    NONE, //the block is written right after the branch, control falls through
+    BREAK, //the block follows the innermost loop or switch
+    CONTINUE //the block is the header of the innermost loop
+};
+
+/**
+ * @brief The ScopeExpr class represents opening or closing brace of a scope between stacksave and stackrestore.
+ */
+class ScopeExpr : public ExprBase {
+public:
+    bool isOpening; //the scope starts here
+
+    ScopeExpr(bool isOpening);
+
+    void accept(ExprVisitor& visitor) override;
+};
+
 /**
  * @brief The IfExpr class represents br instruction in C as an if-else statement.
  */
@@ -155,6 +188,10 @@ public:
     Expr* cmp; //expression used as a condition
     Block* trueBlock; //goto trueBlock if condition is true
     Block* falseBlock; //else goto falseBlock
+    JumpKind trueJump = JumpKind::GOTO; //how trueBlock is reached
+    JumpKind falseJump = JumpKind::GOTO; //how falseBlock is reached
+    std::vector<Expr*> trueCopies; //assignments to phi variables done before going to trueBlock
+    std::vector<Expr*> falseCopies; //assignments to phi variables done before going to falseBlock
 
     IfExpr(Expr*, Block*, Block*);
     IfExpr(Block* trueBlock);
@@ -169,9 +206,18 @@ class SwitchExpr : public ExprBase {
 public:
     Expr* cmp; //expression used in switch
     Block* def; //default
-    std::map<int, Block*> cases; //cases of switch
+    std::vector<std::pair<int64_t, Block*>> cases; //cases of switch sorted by value, sign-extended to 64 bits
+    unsigned bitWidth; //bit width of the compared integer
+    std::map<const Block*, JumpKind> jumps; //how the target blocks are reached, goto if missing
+    std::map<const Block*, std::vector<Expr*>> copies; //assignments to phi variables done before going to the target block
 
-    SwitchExpr(Expr*, Block*, std::map<int, Block*>);
+    SwitchExpr(Expr*, Block*, std::vector<std::pair<int64_t, Block*>>, unsigned);
+
+    /**
+     * @brief targets Returns the distinct target blocks in the order in which they are written
+     * (by their lowest case value, default last unless it is also a case target).
+     */
+    std::vector<Block*> targets() const;
 
     void accept(ExprVisitor& visitor) override;
 };
@@ -206,6 +252,7 @@ public:
     std::string funcName; //name of the called function
     std::vector<Expr*> params; //parameters of the function call
     Expr* funcValue; //expression in case of calling function pointer
+    bool isMustTail = false; //the call must be compiled as a tail call
 
     CallExpr(Expr*, const std::string&, std::vector<Expr*>, std::unique_ptr<Type>);
 
@@ -251,9 +298,75 @@ public:
     void accept(ExprVisitor& visitor) override;
 };
 
+/**
+ * @brief The InsertElementExpr class represents insertelement instruction. It is written as a statement expression
+ * that modifies copy of the vector.
+ */
+class InsertElementExpr : public ExprBase {
+public:
+    Expr* vector; //vector into which the element is inserted
+    Expr* element; //inserted element
+    Expr* index; //expression representing index of the element
+
+    InsertElementExpr(Expr*, Expr*, Expr*);
+
+    void accept(ExprVisitor& visitor) override;
+};
+
+/**
+ * @brief The ShuffleVectorExpr class represents shufflevector instruction in C (__builtin_shufflevector).
+ */
+class ShuffleVectorExpr : public ExprBase {
+public:
+    Expr* left; //first vector
+    Expr* right; //second vector
+    std::vector<int> mask; //indices of the elements of the result, -1 for undefined element
+
+    ShuffleVectorExpr(Expr*, Expr*, const std::vector<int>&, std::unique_ptr<Type>);
+
+    void accept(ExprVisitor& visitor) override;
+};
+
+/**
+ * @brief The AtomicRMWExpr class represents atomicrmw instruction that has no __atomic builtin (min, max and floating point operations).
+ * It is written as a compare-exchange loop in a statement expression and evaluates to the previous value.
+ */
+class AtomicRMWExpr : public ExprBase {
+public:
+    enum class Op { XCHG, MAX, MIN, FADD, FSUB };
+
+    Expr* pointer; //modified memory
+    Expr* value; //second operand of the operation
+    Op op;
+    std::string order; //memory order of the successful exchange
+
+    AtomicRMWExpr(Expr*, Expr*, Op, const std::string&, std::unique_ptr<Type>);
+
+    void accept(ExprVisitor& visitor) override;
+};
+
+/**
+ * @brief The VectorReduceExpr class represents reduction of a vector to a scalar (vector.reduce intrinsics).
+ * It is written as a loop over the elements in a statement expression, the type of the expression is the type of the result.
+ */
+class VectorReduceExpr : public ExprBase {
+public:
+    Expr* vector; //reduced vector
+    Expr* start; //value the reduction starts with, nullptr to start with the first element
+    unsigned size; //number of elements of the vector
+    std::string op; //operator combining the elements (+, *, &, |, ^), or < and > selecting the minimum and maximum
+    std::string builtin; //builtin combining the elements instead of the operator, e.g. __builtin_fmax
+
+    VectorReduceExpr(Expr*, Expr*, unsigned, const std::string&, const std::string&, std::unique_ptr<Type>);
+
+    void accept(ExprVisitor& visitor) override;
+};
+
 class StackAlloc : public ExprBase {
 public:
     Value* value;
+    unsigned alignment = 0; //alignment higher than the natural one of the type, 0 otherwise
+    Expr* count = nullptr; //number of elements of a variable-length array, value is then the pointer to its first element
 
     StackAlloc(Value*);
 
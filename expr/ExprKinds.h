@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @brief EXPR_KINDS Lists the classes of all expressions, KIND is applied to the name of each one.
+ * ExprKind, the methods of ExprVisitor and the dispatch of StaticExprVisitor are generated from it,
+ * a new expression is added here.
+ */
+#define EXPR_KINDS(KIND) \
+    KIND(Struct) \
+    KIND(StructElement) \
+    KIND(ArrayElement) \
+    KIND(ExtractValueExpr) \
+    KIND(Value) \
+    KIND(GlobalValue) \
+    KIND(ScopeExpr) \
+    KIND(IfExpr) \
+    KIND(SwitchExpr) \
+    KIND(AsmExpr) \
+    KIND(CallExpr) \
+    KIND(PointerShift) \
+    KIND(GepExpr) \
+    KIND(SelectExpr) \
+    KIND(RefExpr) \
+    KIND(DerefExpr) \
+    KIND(RetExpr) \
+    KIND(IndirectGotoExpr) \
+    KIND(CastExpr) \
+    KIND(AddExpr) \
+    KIND(SubExpr) \
+    KIND(AssignExpr) \
+    KIND(MulExpr) \
+    KIND(DivExpr) \
+    KIND(RemExpr) \
+    KIND(AndExpr) \
+    KIND(OrExpr) \
+    KIND(XorExpr) \
+    KIND(CmpExpr) \
+    KIND(AshrExpr) \
+    KIND(LshrExpr) \
+    KIND(ShlExpr) \
+    KIND(StackAlloc) \
+    KIND(InsertElementExpr) \
+    KIND(ShuffleVectorExpr) \
+    KIND(ConvertVectorExpr) \
+    KIND(AtomicRMWExpr) \
+    KIND(VectorReduceExpr)
+
+/**
+ * @brief The ExprKind enum identifies the class of an expression, it has the same name as the class.
+ */
+enum class ExprKind {
+#define EXPR_KIND_ENUM(Kind) Kind,
+    EXPR_KINDS(EXPR_KIND_ENUM)
+#undef EXPR_KIND_ENUM
+};
@@ -0,0 +1,99 @@
+#include "ExprSize.h"
+
+#include "StaticExprVisitor.h"
+
+#include <algorithm>
+
+/**
+ * @brief The OperandsCollector collects the operands of an expression without visiting them.
+ */
+class OperandsCollector : public StaticExprVisitor<OperandsCollector> {
+public:
+    std::vector<Expr*> operands;
+
+    void visitOperand(Expr*& operand) {
+        if (operand) {
+            if (operands.empty()) {
+                operands.reserve(2); // most expressions are binary
+            }
+            operands.push_back(operand);
+        }
+    }
+
+    // the last index contains the previous ones
+    void visitExtractValueExpr(ExtractValueExpr& expr) {
+        operands.push_back(expr.indices.back().get());
+    }
+
+    void visitGepExpr(GepExpr& expr) {
+        operands.push_back(expr.indices.back().get());
+    }
+
+    void visitIfExpr(IfExpr& expr) {
+        visitOperand(expr.cmp);
+    }
+
+    void visitSwitchExpr(SwitchExpr& expr) {
+        visitOperand(expr.cmp);
+    }
+};
+
+std::vector<Expr*> getOperands(Expr* expr) {
+    OperandsCollector collector;
+    collector.visit(expr);
+    return collector.operands;
+}
+
+const std::pair<unsigned, uint64_t>& ExprSize::measure(Expr* expr) {
+    auto found = measured.find(expr);
+    if (found != measured.end()) {
+        return found->second;
+    }
+
+    // post-order walk, an expression is measured once all its operands are
+    std::vector<std::pair<Expr*, bool>> stack = {{expr, false}};
+    while (!stack.empty()) {
+        auto current = stack.back();
+        stack.pop_back();
+
+        if (measured.count(current.first)) {
+            continue;
+        }
+
+        auto operands = getOperands(current.first);
+        if (!current.second) {
+            stack.push_back({current.first, true});
+            for (auto operand : operands) {
+                if (!measured.count(operand)) {
+                    stack.push_back({operand, false});
+                }
+            }
+            continue;
+        }
+
+        unsigned depth = 0;
+        uint64_t size = 1;
+        for (auto operand : operands) {
+            const auto& result = measured[operand];
+            depth = std::max(depth, result.first);
+            // saturate instead of overflowing on exponentially shared expressions
+            size = std::min(size + result.second, UINT64_MAX / 2);
+        }
+        measured[current.first] = {depth + 1, size};
+    }
+
+    return measured[expr];
+}
+
+unsigned ExprSize::depth(Expr* expr) {
+    return measure(expr).first;
+}
+
+uint64_t ExprSize::size(Expr* expr) {
+    return measure(expr).second;
+}
+
+bool ExprSize::isTooLarge(Expr* expr, unsigned extraDepth, unsigned copies) {
+    const auto& result = measure(expr);
+    return result.first + extraDepth > MAX_EXPR_DEPTH || result.second > MAX_EXPR_SIZE / std::max(copies, 1u);
+}
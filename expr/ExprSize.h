@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "Expr.h"
+
+/**
+ * @brief MAX_EXPR_DEPTH Depth of the deepest expression written as one C expression, longer chains of
+ * instructions are split by temporaries. Casts and parentheses added for the nodes must stay below
+ * the nesting limits of C compilers, e.g. -fbracket-depth=256 of clang.
+ */
+constexpr unsigned MAX_EXPR_DEPTH = 64;
+
+/**
+ * @brief MAX_EXPR_SIZE Number of nodes of the largest expression written as one C expression.
+ * Subexpressions used more than once are written every time, so the size may grow exponentially.
+ */
+constexpr uint64_t MAX_EXPR_SIZE = 64;
+
+/**
+ * @brief getOperands Returns the subexpressions of the expression, without the statements of phi copies.
+ */
+std::vector<Expr*> getOperands(Expr* expr);
+
+/**
+ * @brief The ExprSize class measures expressions as they are written. Expressions are walked
+ * with an explicit stack, so they may be arbitrarily deep.
+ */
+class ExprSize {
+private:
+    // expression -> its depth and size, valid while the measured expressions do not change
+    llvm::DenseMap<const Expr*, std::pair<unsigned, uint64_t>> measured;
+
+    const std::pair<unsigned, uint64_t>& measure(Expr* expr);
+
+public:
+    /**
+     * @brief depth Returns the number of nodes on the longest path from the expression to a leaf.
+     */
+    unsigned depth(Expr* expr);
+
+    /**
+     * @brief size Returns the number of nodes of the expression with shared subexpressions counted for every use.
+     */
+    uint64_t size(Expr* expr);
+
+    /**
+     * @brief isTooLarge Returns whether the expression exceeds MAX_EXPR_DEPTH when written @extraDepth levels deep,
+     * or MAX_EXPR_SIZE when written @copies times.
+     */
+    bool isTooLarge(Expr* expr, unsigned extraDepth = 0, unsigned copies = 1);
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Expr.h"
+#include "UnaryExpr.h"
+#include "BinaryExpr.h"
+
+/**
+ * @brief The StaticExprVisitor class is a visitor dispatched at compile time. visit switches on the kind of
+ * the expression and calls visit<Kind> of Derived (e.g. visitAddExpr), which by default visits the children.
+ * Derived defines only the visit<Kind> methods it needs, and visitOperand to handle every operand.
+ */
+template<typename Derived>
+class StaticExprVisitor {
+public:
+    void visit(Expr* expr) {
+        switch (expr->kind) {
+#define EXPR_KIND_DISPATCH(Kind) \
+        case ExprKind::Kind: \
+            return derived().visit##Kind(static_cast<Kind&>(*expr));
+        EXPR_KINDS(EXPR_KIND_DISPATCH)
+#undef EXPR_KIND_DISPATCH
+        }
+    }
+
+#define EXPR_KIND_VISIT(Kind) \
+    void visit##Kind(Kind& expr) { \
+        visitChildren(expr); \
+    }
+    EXPR_KINDS(EXPR_KIND_VISIT)
+#undef EXPR_KIND_VISIT
+
+    /**
+     * @brief visitOperand Visits an operand of an expression. It is passed by reference, so Derived may replace it.
+     * @param operand Operand, nullptr if the expression does not have it (e.g. RetExpr of void function)
+     */
+    void visitOperand(Expr*& operand) {
+        if (operand) {
+            derived().visit(operand);
+        }
+    }
+
+protected:
+    Derived& derived() {
+        return static_cast<Derived&>(*this);
+    }
+
+    /*
+     * visitChildren passes the operands to visitOperand, and visits the expressions owned by the expression
+     * (indices of gep and extractvalue) and the assignments to phi variables of branches.
+     */
+
+    void visitChildren(Struct&) { }
+
+    void visitChildren(Value&) { }
+
+    void visitChildren(ScopeExpr&) { }
+
+    void visitChildren(UnaryExpr& expr) {
+        derived().visitOperand(expr.expr);
+    }
+
+    void visitChildren(BinaryExpr& expr) {
+        derived().visitOperand(expr.left);
+        derived().visitOperand(expr.right);
+    }
+
+    void visitChildren(StructElement& expr) {
+        derived().visitOperand(expr.expr);
+    }
+
+    void visitChildren(ArrayElement& expr) {
+        derived().visitOperand(expr.expr);
+        derived().visitOperand(expr.element);
+    }
+
+    void visitChildren(ExtractValueExpr& expr) {
+        for (auto& index : expr.indices) {
+            derived().visit(index.get());
+        }
+    }
+
+    void visitChildren(IfExpr& expr) {
+        derived().visitOperand(expr.cmp);
+        for (auto copy : expr.trueCopies) {
+            derived().visit(copy);
+        }
+        for (auto copy : expr.falseCopies) {
+            derived().visit(copy);
+        }
+    }
+
+    void visitChildren(SwitchExpr& expr) {
+        derived().visitOperand(expr.cmp);
+        for (const auto& target : expr.copies) {
+            for (auto copy : target.second) {
+                derived().visit(copy);
+            }
+        }
+    }
+
+    void visitChildren(AsmExpr& expr) {
+        for (auto& out : expr.output) {
+            derived().visitOperand(out.second);
+        }
+        for (auto& in : expr.input) {
+            derived().visitOperand(in.second);
+        }
+    }
+
+    void visitChildren(CallExpr& expr) {
+        derived().visitOperand(expr.funcValue);
+        for (auto& param : expr.params) {
+            derived().visitOperand(param);
+        }
+    }
+
+    void visitChildren(PointerShift& expr) {
+        derived().visitOperand(expr.pointer);
+        derived().visitOperand(expr.move);
+    }
+
+    void visitChildren(GepExpr& expr) {
+        for (auto& index : expr.indices) {
+            derived().visit(index.get());
+        }
+    }
+
+    void visitChildren(SelectExpr& expr) {
+        derived().visitOperand(expr.comp);
+        derived().visitOperand(expr.left);
+        derived().visitOperand(expr.right);
+    }
+
+    void visitChildren(InsertElementExpr& expr) {
+        derived().visitOperand(expr.vector);
+        derived().visitOperand(expr.element);
+        derived().visitOperand(expr.index);
+    }
+
+    void visitChildren(ShuffleVectorExpr& expr) {
+        derived().visitOperand(expr.left);
+        derived().visitOperand(expr.right);
+    }
+
+    void visitChildren(AtomicRMWExpr& expr) {
+        derived().visitOperand(expr.pointer);
+        derived().visitOperand(expr.value);
+    }
+
+    void visitChildren(VectorReduceExpr& expr) {
+        derived().visitOperand(expr.vector);
+        derived().visitOperand(expr.start);
+    }
+
+    void visitChildren(StackAlloc& expr) {
+        derived().visitOperand(expr.count);
+    }
+};
@@ -6,7 +6,8 @@
  * UnaryExpr classes
  */
 
-UnaryExpr::UnaryExpr(Expr *expr) {
+UnaryExpr::UnaryExpr(ExprKind kind, Expr *expr)
+    : ExprBase(kind) {
     this->expr = expr;
     if (expr) {
         setType(expr->getType()->clone());
@@ -14,7 +15,7 @@ UnaryExpr::UnaryExpr(Expr *expr) {
 }
 
 RefExpr::RefExpr(Expr* expr) :
-    UnaryExpr(expr) {
+    UnaryExpr(ExprKind::RefExpr, expr) {
     setType(std::make_unique<PointerType>(expr->getType()->clone()));
 }
 
@@ -23,7 +24,7 @@ void RefExpr::accept(ExprVisitor& visitor) {
 }
 
 DerefExpr::DerefExpr(Expr* expr) :
-    UnaryExpr(expr) {
+    UnaryExpr(ExprKind::DerefExpr, expr) {
     if (auto PT = dynamic_cast<PointerType*>(expr->getType())) {
         setType(PT->type->clone());
     }
@@ -34,17 +35,24 @@ void DerefExpr::accept(ExprVisitor& visitor) {
 }
 
 RetExpr::RetExpr(Expr* ret)
-    : UnaryExpr(ret) { }
+    : UnaryExpr(ExprKind::RetExpr, ret) { }
 
 RetExpr::RetExpr()
-    : UnaryExpr(nullptr) { }
+    : UnaryExpr(ExprKind::RetExpr, nullptr) { }
 
 void RetExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
+IndirectGotoExpr::IndirectGotoExpr(Expr* address)
+    : UnaryExpr(ExprKind::IndirectGotoExpr, address) { }
+
+void IndirectGotoExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
+
 CastExpr::CastExpr(Expr* expr, std::unique_ptr<Type> type)
-    : UnaryExpr(expr) {
+    : UnaryExpr(ExprKind::CastExpr, expr) {
     setType(std::move(type));
 }
 
@@ -52,3 +60,11 @@ void CastExpr::accept(ExprVisitor& visitor) {
     visitor.visit(*this);
 }
 
+ConvertVectorExpr::ConvertVectorExpr(Expr* expr, std::unique_ptr<Type> type)
+    : UnaryExpr(ExprKind::ConvertVectorExpr, expr) {
+    setType(std::move(type));
+}
+
+void ConvertVectorExpr::accept(ExprVisitor& visitor) {
+    visitor.visit(*this);
+}
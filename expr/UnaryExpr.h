@@ -9,7 +9,7 @@
  */
 class UnaryExpr : public ExprBase {
 public:
-    UnaryExpr(Expr *);
+    UnaryExpr(ExprKind, Expr *);
 
     Expr* expr; //operand of unary operation
 };
@@ -29,6 +29,8 @@ public:
  */
 class DerefExpr : public UnaryExpr {
 public:
+    bool isVolatile = false; //volatile load, it is neither moved nor merged with other accesses
+
     DerefExpr(Expr*);
 
     void accept(ExprVisitor& visitor) override;
@@ -45,6 +47,16 @@ public:
     void accept(ExprVisitor& visitor) override;
 };
 
+/**
+ * @brief The IndirectGotoExpr class represents computed goto to the address of a label (indirectbr).
+ */
+class IndirectGotoExpr : public UnaryExpr {
+public:
+    IndirectGotoExpr(Expr*);
+
+    void accept(ExprVisitor& visitor) override;
+};
+
 /**
  * @brief The CastExpr class represents cast.
  */
@@ -54,3 +66,13 @@ public:
 
     void accept(ExprVisitor& visitor) override;
 };
+
+/**
+ * @brief The ConvertVectorExpr class represents elementwise conversion of a vector (__builtin_convertvector).
+ */
+class ConvertVectorExpr : public UnaryExpr {
+public:
+    ConvertVectorExpr(Expr*, std::unique_ptr<Type>);
+
+    void accept(ExprVisitor& visitor) override;
+};
@@ -32,6 +32,10 @@ int main(int argc, char** argv) {
         ProgramParser parser;
         auto program = parser.parse(Input);
 
+        if (Debug) {
+            program.printConstantPoolStats(std::cout);
+        }
+
         if (Print) {
             Writer wr{ std::cout, Includes, Casts };
             wr.writeProgram(program);
@@ -25,19 +25,26 @@ Program ProgramParser::parse(const std::string& file) {
     createFunctions(mod, result);
     nameFunctions(mod, result);
     createFunctionParameters(mod, result);
+    parseFunctionAttributes(mod, result);
     createBlocks(mod, result);
-    identifyInlinableBlocks(mod, result);
+    parseBlockAddressTables(mod, result);
     createAllocas(mod, result);
     parseMetadataTypes(mod, result);
+    createPhiVariables(mod, result);
     createExpressions(mod, result);
-    addPhis(mod, result);
     parseBreaks(mod, result);
+    addPhis(mod, result);
 
     // transformations of resulting expressions
     fixMainParameters(mod, result);
     addSignCasts(mod, result);
 
     refDeref(mod, result);
+    foldTemporaries(mod, result);
+
+    // decide how blocks are written, after the expressions are final
+    structureBlocks(mod, result);
+    scopeVariables(mod, result);
 
     return result;
 }
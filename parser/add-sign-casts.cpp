@@ -5,43 +5,27 @@
 #include "../core/Func.h"
 #include "../core/Block.h"
 
-#include "../expr/ExprVisitor.h"
+#include "../expr/StaticExprVisitor.h"
 
-class SignCastsVisitor : public ExprVisitor {
+class SignCastsVisitor : public StaticExprVisitor<SignCastsVisitor> {
     Block* block;
 
     Expr* castIfNeeded(Expr* expr, bool isUnsigned);
+    void castOperands(BinaryExpr& expr, bool isUnsigned);
 
 public:
     SignCastsVisitor(Block* block) : block(block) {}
 
-    void visit(StructElement& expr) override;
-    void visit(ArrayElement& expr) override;
-    void visit(ExtractValueExpr& expr) override;
-    void visit(IfExpr& expr) override;
-    void visit(SwitchExpr& expr) override;
-    void visit(AsmExpr& expr) override;
-    void visit(CallExpr& expr) override;
-    void visit(PointerShift& expr) override;
-    void visit(GepExpr& expr) override;
-    void visit(SelectExpr& expr) override;
-    void visit(RefExpr& expr) override;
-    void visit(DerefExpr& expr) override;
-    void visit(RetExpr& expr) override;
-    void visit(CastExpr& expr) override;
-    void visit(AddExpr& expr) override;
-    void visit(SubExpr& expr) override;
-    void visit(AssignExpr& expr) override;
-    void visit(MulExpr& expr) override;
-    void visit(DivExpr& expr) override;
-    void visit(RemExpr& expr) override;
-    void visit(AndExpr& expr) override;
-    void visit(OrExpr& expr) override;
-    void visit(XorExpr& expr) override;
-    void visit(CmpExpr& expr) override;
-    void visit(AshrExpr& expr) override;
-    void visit(LshrExpr& expr) override;
-    void visit(ShlExpr& expr) override;
+    void visitAddExpr(AddExpr& expr);
+    void visitSubExpr(SubExpr& expr);
+    void visitMulExpr(MulExpr& expr);
+    void visitDivExpr(DivExpr& expr);
+    void visitRemExpr(RemExpr& expr);
+    void visitAshrExpr(AshrExpr& expr);
+    void visitLshrExpr(LshrExpr& expr);
+    void visitShlExpr(ShlExpr& expr);
+    void visitCmpExpr(CmpExpr& expr);
+    void visitAsmExpr(AsmExpr& expr) { }
 };
 
 
@@ -54,19 +38,13 @@ void addSignCasts(const llvm::Module* module, Program& program) {
 
             for (auto it = myBlock->expressions.begin(); it != myBlock->expressions.end(); ++it) {
                 auto expr = *it;
-                expr->accept(scv);
+                scv.visit(expr);
 
             }
         }
     }
 }
 
-void SignCastsVisitor::visit(IfExpr& expr) {
-    if (expr.cmp) {
-        expr.cmp->accept(*this);
-    }
-}
-
 Expr* SignCastsVisitor::castIfNeeded(Expr* expr, bool isUnsigned) {
     Expr* result = expr;
     auto IT = dynamic_cast<IntegerType*>(expr->getType());
@@ -76,164 +54,63 @@ Expr* SignCastsVisitor::castIfNeeded(Expr* expr, bool isUnsigned) {
         static_cast<IntegerType*>(newType.get())->unsignedType = isUnsigned;
         auto cast = std::make_unique<CastExpr>(expr, std::move(newType));
         result = cast.get();
-        block->ownership.push_back(std::move(cast));
+        block->own(std::move(cast));
     }
 
     return result;
 }
 
-void SignCastsVisitor::visit(CmpExpr& expr) {
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
-}
-
-void SignCastsVisitor::visit(StructElement& expr) {
-    expr.expr->accept(*this);
-}
-
-void SignCastsVisitor::visit(ArrayElement& ae) {
-    ae.expr->accept(*this);
-    ae.element->accept(*this);
-}
-
-void SignCastsVisitor::visit(ExtractValueExpr& expr) {
-    for (auto& index : expr.indices) {
-        index->accept(*this);
-    }
-}
-
-void SignCastsVisitor::visit(SwitchExpr& expr) {
-    expr.cmp->accept(*this);
-}
-
-void SignCastsVisitor::visit(AsmExpr& expr) {
-}
-
-void SignCastsVisitor::visit(CallExpr& expr) {
-    if (expr.funcValue) {
-        expr.funcValue->accept(*this);
-    }
-
-    for (auto it = expr.params.begin(); it != expr.params.end(); ++it) {
-        (*it)->accept(*this);
-    }
-}
-
-void SignCastsVisitor::visit(PointerShift& expr) {
-    expr.pointer->accept(*this);
-    expr.move->accept(*this);
-}
+void SignCastsVisitor::castOperands(BinaryExpr& expr, bool isUnsigned) {
+    expr.left = castIfNeeded(expr.left, isUnsigned);
+    expr.right = castIfNeeded(expr.right, isUnsigned);
 
-void SignCastsVisitor::visit(GepExpr& expr) {
-    for (auto& index : expr.indices) {
-        index->accept(*this);
+    // the operation is done in the type of its operands
+    if (auto IT = dynamic_cast<IntegerType*>(expr.getType())) {
+        IT->unsignedType = isUnsigned;
     }
 }
 
-void SignCastsVisitor::visit(SelectExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-    expr.comp->accept(*this);
-}
-
-void SignCastsVisitor::visit(RefExpr& expr) {
-    expr.expr->accept(*this);
-}
-
-void SignCastsVisitor::visit(DerefExpr& expr) {
-    expr.expr->accept(*this);
-}
-
-void SignCastsVisitor::visit(RetExpr& expr) {
-    if (expr.expr) {
-        expr.expr->accept(*this);
-    }
-}
-
-void SignCastsVisitor::visit(CastExpr& expr) {
-    expr.expr->accept(*this);
-}
-
-void SignCastsVisitor::visit(AddExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
+void SignCastsVisitor::visitCmpExpr(CmpExpr& expr) {
     expr.left = castIfNeeded(expr.left, expr.isUnsigned);
     expr.right = castIfNeeded(expr.right, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(SubExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
+void SignCastsVisitor::visitAddExpr(AddExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(AssignExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
+void SignCastsVisitor::visitSubExpr(SubExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(MulExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
+void SignCastsVisitor::visitMulExpr(MulExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(DivExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
+void SignCastsVisitor::visitDivExpr(DivExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(RemExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
+void SignCastsVisitor::visitRemExpr(RemExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(AndExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
+void SignCastsVisitor::visitAshrExpr(AshrExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(OrExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
+void SignCastsVisitor::visitLshrExpr(LshrExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
 
-void SignCastsVisitor::visit(XorExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-}
-
-void SignCastsVisitor::visit(AshrExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
-}
-
-void SignCastsVisitor::visit(LshrExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
-}
-
-void SignCastsVisitor::visit(ShlExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = castIfNeeded(expr.left, expr.isUnsigned);
-    expr.right = castIfNeeded(expr.right, expr.isUnsigned);
+void SignCastsVisitor::visitShlExpr(ShlExpr& expr) {
+    visitChildren(expr);
+    castOperands(expr, expr.isUnsigned);
 }
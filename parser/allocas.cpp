@@ -1,26 +1,111 @@
 #include <llvm/IR/Instruction.h>
+#include <llvm/IR/IntrinsicInst.h>
 #include "../core/Program.h"
 #include "../core/Func.h"
 #include "../core/Block.h"
 
+#include <algorithm>
+
+/*
+ * Allocas of a constant size become local variables. Dynamic allocas are written
+ * as variable-length arrays where their memory is freed no earlier than at the end
+ * of the C scope: in the entry block, or between stacksave and stackrestore of one
+ * block, which are written as braces. Other dynamic allocas use __builtin_alloca_with_align.
+ */
+
+static bool isIntrinsicCall(const llvm::Value* value, llvm::Intrinsic::ID id) {
+    auto* call = llvm::dyn_cast<llvm::IntrinsicInst>(value);
+    return call && call->getIntrinsicID() == id;
+}
+
+// stacksave whose result is restored, directly or through a local variable stored in the same block
+static const llvm::Value* findStackSave(const llvm::CallInst& restore) {
+    const llvm::Value* saved = restore.getArgOperand(0);
+
+    if (auto load = llvm::dyn_cast<llvm::LoadInst>(saved)) {
+        if (load->getParent() != restore.getParent()) {
+            return nullptr;
+        }
+
+        saved = nullptr;
+        for (const auto& ins : *restore.getParent()) {
+            if (&ins == load) {
+                break;
+            }
+
+            auto store = llvm::dyn_cast<llvm::StoreInst>(&ins);
+            if (store && store->getPointerOperand() == load->getPointerOperand()) {
+                saved = store->getValueOperand();
+            }
+        }
+    }
+
+    if (!saved || !isIntrinsicCall(saved, llvm::Intrinsic::stacksave)) {
+        return nullptr;
+    }
+
+    return llvm::cast<llvm::Instruction>(saved)->getParent() == restore.getParent() ? saved : nullptr;
+}
+
+// pairs of stacksave and stackrestore which nest properly become scopes
+static void findStackScopes(const llvm::BasicBlock& block, Block* myBlock) {
+    std::vector<const llvm::Value*> open;
+
+    for (const auto& ins : block) {
+        if (isIntrinsicCall(&ins, llvm::Intrinsic::stacksave)) {
+            open.push_back(&ins);
+        } else if (isIntrinsicCall(&ins, llvm::Intrinsic::stackrestore)) {
+            auto it = std::find(open.begin(), open.end(), findStackSave(llvm::cast<llvm::CallInst>(ins)));
+            if (it == open.end()) {
+                continue;
+            }
+
+            // saves opened later are never restored, they do not start a scope
+            myBlock->createTables().stackScopes.insert(llvm::cast<llvm::Instruction>(*it));
+            myBlock->createTables().stackScopes.insert(&ins);
+            open.erase(it, open.end());
+        }
+    }
+
+    // dynamic allocas between the braces
+    int depth = 0;
+    for (const auto& ins : block) {
+        if (myBlock->getTables().stackScopes.count(&ins)) {
+            depth += isIntrinsicCall(&ins, llvm::Intrinsic::stacksave) ? 1 : -1;
+        }
+
+        auto alloca = llvm::dyn_cast<llvm::AllocaInst>(&ins);
+        if (alloca && alloca->isArrayAllocation() && (depth > 0 || &block == &block.getParent()->getEntryBlock())) {
+            myBlock->createTables().arrayAllocas.insert(&ins);
+        }
+    }
+}
+
 void createAllocas(const llvm::Module* module, Program& program) {
     for (const auto& function : module->functions()) {
         auto* func = program.getFunction(&function);
         for (const auto& block : function) {
             auto* myBlock = func->getBlock(&block);
+            findStackScopes(block, myBlock);
 
             for (const auto& ins : block) {
                 if (ins.getOpcode() == llvm::Instruction::Alloca) {
 
                     const auto allocaInst = llvm::cast<const llvm::AllocaInst>(&ins);
 
+                    // dynamic allocas are created with the other expressions, they need the value of their size
+                    if (allocaInst->isArrayAllocation()) {
+                        continue;
+                    }
+
                     auto theVariable = std::make_unique<Value>(func->getVarName(), func->getType(allocaInst->getAllocatedType()));
                     auto alloc = std::make_unique<StackAlloc>(theVariable.get());
+                    alloc->alignment = TypeHandler::getOverAlignment(allocaInst->getAllocatedType(), allocaInst->getAlignment(), module->getDataLayout());
 
                     myBlock->addExpr(alloc.get());
 
                     myBlock->insertValue(&ins, std::move(theVariable));
-                    myBlock->allocas.push_back(std::move(alloc));
+                    myBlock->own(std::move(alloc));
                 }
             }
 
@@ -0,0 +1,245 @@
+#include "../core/Program.h"
+#include "../core/Func.h"
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Attributes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Operator.h>
+
+#include <set>
+#include <sstream>
+
+/*
+ * LLVM attributes with a GCC counterpart are written as __attribute__((...)) of the function,
+ * noalias pointer parameters are declared with restrict and aligned parameters
+ * are passed through __builtin_assume_aligned at the start of the function body.
+ * Functions built for other than the baseline x86-64 target get __attribute__((target("..."))).
+ * Fast-math flags shared by all floating-point operations of a function become __attribute__((optimize("..."))).
+ */
+
+//LLVM function attribute -> GCC function attribute
+static const std::vector<std::pair<llvm::Attribute::AttrKind, std::string>> FUNCTION_ATTRIBUTES = {
+    {llvm::Attribute::AlwaysInline, "always_inline"},
+    {llvm::Attribute::NoInline, "noinline"},
+    {llvm::Attribute::Cold, "cold"},
+    {llvm::Attribute::NoReturn, "noreturn"},
+    {llvm::Attribute::ReturnsTwice, "returns_twice"},
+};
+
+//CPUs and features of the x86-64 baseline, functions using only these are compiled for the target chosen by the user
+static const std::set<std::string> BASELINE_CPUS = {"", "generic", "x86-64"};
+static const std::set<std::string> BASELINE_FEATURES = {"cx8", "fxsr", "mmx", "sse", "sse2", "x87", "64bit"};
+
+//LLVM target features which are also GCC target options
+static const std::set<std::string> GCC_FEATURES = {
+    "mmx", "sse", "sse2", "sse3", "ssse3", "sse4.1", "sse4.2", "sse4a", "avx", "avx2", "fma", "fma4", "xop", "f16c",
+    "avx512f", "avx512bw", "avx512dq", "avx512vl", "avx512cd", "avx512vnni", "avx512bf16", "avx512ifma", "avx512vbmi",
+    "avx512vbmi2", "avx512bitalg", "avx512vpopcntdq", "avx512fp16", "avxvnni", "bmi", "bmi2", "popcnt", "lzcnt", "movbe",
+    "aes", "pclmul", "vpclmulqdq", "vaes", "gfni", "sha", "xsave", "xsaveopt", "xsavec", "xsaves", "rdrnd", "rdseed",
+    "adx", "fsgsbase", "prfchw", "clflushopt", "clwb", "cx16", "sahf", "fxsr", "crc32", "tbm", "lwp", "mwaitx", "clzero",
+    "wbnoinvd", "pku", "rdpid", "ptwrite", "waitpkg", "movdiri", "movdir64b", "serialize", "tsxldtrk", "enqcmd",
+    "cldemote", "rtm", "sgx", "shstk", "uintr", "hreset", "kl", "widekl", "amx-tile", "amx-int8", "amx-bf16",
+};
+
+static std::string getFnAttributeString(const llvm::Function& function, const std::string& name) {
+    return function.getFnAttribute(name).getValueAsString().str();
+}
+
+//"target-cpu"="haswell" "target-features"="+avx2,+fma,-avx512f" -> target("arch=haswell,avx2,fma,no-avx512f")
+static std::string getTarget(const llvm::Function& function) {
+    std::vector<std::string> options;
+
+    std::string cpu = getFnAttributeString(function, "target-cpu");
+    bool hasArch = !BASELINE_CPUS.count(cpu);
+    if (hasArch) {
+        options.push_back("arch=" + cpu);
+    }
+
+    std::string tune = getFnAttributeString(function, "tune-cpu");
+    if (!BASELINE_CPUS.count(tune)) {
+        options.push_back("tune=" + tune);
+    }
+
+    std::stringstream features(getFnAttributeString(function, "target-features"));
+    std::string feature;
+    while (std::getline(features, feature, ',')) {
+        std::string name = feature.substr(1);
+        if (!GCC_FEATURES.count(name)) {
+            continue;
+        }
+
+        if (feature[0] == '+' && !BASELINE_FEATURES.count(name)) {
+            options.push_back(name);
+        }
+
+        //disabled features only matter if they would be enabled by the cpu
+        if (feature[0] == '-' && hasArch) {
+            options.push_back("no-" + name);
+        }
+    }
+
+    std::string target;
+    for (const auto& option : options) {
+        target += (target.empty() ? "" : ",") + option;
+    }
+
+    return target;
+}
+
+//fast-math flags common to all floating-point operations -> optimize("associative-math", ...)
+static std::string getFastMath(const llvm::Function& function) {
+    bool hasFPMath = false;
+    llvm::FastMathFlags flags;
+    flags.setFast();
+
+    for (const auto& ins : llvm::instructions(function)) {
+        //phis, selects and calls only pass floating-point values along
+        if (!ins.isBinaryOp() && !llvm::isa<llvm::FCmpInst>(ins)) {
+            continue;
+        }
+
+        if (auto op = llvm::dyn_cast<llvm::FPMathOperator>(&ins)) {
+            hasFPMath = true;
+            flags &= op->getFastMathFlags();
+        }
+    }
+
+    if (!hasFPMath) {
+        return "";
+    }
+
+    std::vector<std::string> options;
+    if (flags.allowReassoc()) {
+        options.push_back("associative-math");
+    }
+    if (flags.noSignedZeros()) {
+        options.push_back("no-signed-zeros");
+    }
+    if (flags.allowReciprocal()) {
+        options.push_back("reciprocal-math");
+    }
+    if (flags.noNaNs() && flags.noInfs()) {
+        options.push_back("finite-math-only");
+    }
+    if (flags.allowContract()) {
+        options.push_back("fp-contract=fast");
+    }
+
+    //GCC ignores associative-math unless traps of floating-point operations may be ignored as well
+    if (!options.empty()) {
+        options.push_back("no-trapping-math");
+    }
+
+    std::string optimize;
+    for (const auto& option : options) {
+        optimize += (optimize.empty() ? "\"" : ", \"") + option + "\"";
+    }
+
+    return optimize;
+}
+
+//GCC may remove calls of const/pure functions whose result is unused, so only functions that return normally are marked.
+//Since LLVM 12 a function without willreturn may loop forever, unless mustprogress makes such a loop undefined.
+//Older versions assume that functions not writing memory return, as GCC does.
+static bool mayBePure(const llvm::Function& function) {
+    if (function.getReturnType()->isVoidTy() || !function.doesNotThrow() || function.doesNotReturn()) {
+        return false;
+    }
+
+#if LLVM_VERSION_MAJOR >= 12
+    return function.hasFnAttribute(llvm::Attribute::WillReturn) || function.hasFnAttribute(llvm::Attribute::MustProgress);
+#else
+    return true;
+#endif
+}
+
+static void parseAttributes(const llvm::Function& function, FuncDecl* func) {
+    for (const auto& attribute : FUNCTION_ATTRIBUTES) {
+        if (function.hasFnAttribute(attribute.first)) {
+            func->attributes.push_back(attribute.second);
+        }
+    }
+
+    if (mayBePure(function)) {
+        if (function.doesNotAccessMemory()) {
+            func->attributes.push_back("const");
+        } else if (function.onlyReadsMemory()) {
+            func->attributes.push_back("pure");
+        }
+    }
+
+    const auto& attributes = function.getAttributes();
+#if LLVM_VERSION_MAJOR >= 14
+    bool isNoAlias = attributes.hasRetAttr(llvm::Attribute::NoAlias);
+    bool isNonNull = attributes.hasRetAttr(llvm::Attribute::NonNull);
+#else
+    bool isNoAlias = attributes.hasAttribute(llvm::AttributeList::ReturnIndex, llvm::Attribute::NoAlias);
+    bool isNonNull = attributes.hasAttribute(llvm::AttributeList::ReturnIndex, llvm::Attribute::NonNull);
+#endif
+
+    if (isNoAlias) {
+        func->attributes.push_back("malloc");
+    }
+
+    if (isNonNull) {
+        func->attributes.push_back("returns_nonnull");
+    }
+
+#if LLVM_VERSION_MAJOR >= 10
+    uint64_t alignment = attributes.getRetAlignment() ? attributes.getRetAlignment()->value() : 0;
+#else
+    unsigned alignment = attributes.getRetAlignment();
+#endif
+    if (alignment > 1) {
+        func->attributes.push_back("assume_aligned(" + std::to_string(alignment) + ")");
+    }
+
+    std::string nonNull;
+    for (const auto& arg : function.args()) {
+        if (!arg.getType()->isPointerTy()) {
+            continue;
+        }
+
+        //dereferenceable pointers are never null
+        if (arg.hasNonNullAttr() || arg.getDereferenceableBytes() > 0) {
+            nonNull += (nonNull.empty() ? "" : ", ") + std::to_string(arg.getArgNo() + 1);
+        }
+
+        const Value* param = func->parameters[arg.getArgNo()];
+        if (arg.hasNoAliasAttr()) {
+            func->restrictParams.insert(param);
+        }
+
+        if (arg.getParamAlignment() > 1) {
+            func->alignedParams[param] = arg.getParamAlignment();
+        }
+    }
+
+    if (!nonNull.empty()) {
+        func->attributes.push_back("nonnull(" + nonNull + ")");
+    }
+
+    std::string target = getTarget(function);
+    if (!target.empty()) {
+        func->attributes.push_back("target(\"" + target + "\")");
+    }
+
+    std::string fastMath = getFastMath(function);
+    if (!fastMath.empty()) {
+        func->attributes.push_back("optimize(" + fastMath + ")");
+    }
+}
+
+void parseFunctionAttributes(const llvm::Module* module, Program& program) {
+    for (const llvm::Function& function : module->functions()) {
+        if (auto* func = program.getFunction(&function)) {
+            parseAttributes(function, func);
+        }
+
+        if (auto* decl = program.getDeclaration(&function)) {
+            parseAttributes(function, decl);
+        }
+    }
+}
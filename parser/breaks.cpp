@@ -3,6 +3,7 @@
 #include "../core/Block.h"
 #include "cfunc.h"
 #include "constval.h"
+#include "intrinsics.h"
 
 #include <llvm/IR/Instruction.h>
 
@@ -20,7 +21,7 @@ static void parseBrInstruction(const llvm::Instruction& ins, bool isConstExpr, c
         return;
     }
 
-    Expr* cmp = func->getExpr(ins.getOperand(0));
+    Expr* cmp = expectBranch(ins, func->getExpr(ins.getOperand(0)), func, block);
 
     Block* falseBlock = func->createBlockIfNotExist((llvm::BasicBlock*)ins.getOperand(1));
     Block* trueBlock = func->createBlockIfNotExist((llvm::BasicBlock*)ins.getOperand(2));
@@ -38,10 +39,7 @@ static void parseRetInstruction(const llvm::Instruction& ins, bool isConstExpr,
     if (ins.getNumOperands() == 0) {
         func->createExpr(value, std::make_unique<RetExpr>());
     } else {
-        if (func->getExpr(ins.getOperand(0)) == nullptr) {
-            createConstantValue(ins.getOperand(0), func, block);
-        }
-        Expr* expr = func->getExpr(ins.getOperand(0));
+        Expr* expr = func->getOrCreateExpr(ins.getOperand(0), block);
 
         func->createExpr(value, std::make_unique<RetExpr>(expr));
     }
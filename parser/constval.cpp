@@ -1,16 +1,90 @@
 #include "constval.h"
+#include "../expr/ExprSize.h"
 
 void parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block *block);
 
+//nested constant expressions are bounded like chains of instructions. The expression of the constant is shared by all blocks
+//of the function and depends on no instruction, so its temporary is assigned at the start of the entry block.
+static void splitLargeConstantExpression(const llvm::Value* val, Func* func) {
+    Expr* expr = func->getExpr(val);
+    if (!expr || dynamic_cast<Value*>(expr) || val->getType()->isVoidTy() || val->getType()->isArrayTy()) {
+        return;
+    }
+
+    if (!ExprSize().isTooLarge(expr)) {
+        return;
+    }
+
+    Block* entry = func->getBlock(&func->function->getEntryBlock());
+    entry->own(func->releaseExpr(val));
+
+    auto var = std::make_unique<Value>(func->getVarName(), expr->getType()->clone());
+    auto alloca = std::make_unique<StackAlloc>(var.get());
+    auto assign = std::make_unique<AssignExpr>(var.get(), expr);
+
+    //inner constant expressions are created first, their temporaries are kept before the outer ones
+    entry->expressions.insert(entry->expressions.begin() + func->constantTemporaries, {alloca.get(), assign.get()});
+    func->constantTemporaries += 2;
+
+    func->createExpr(val, std::move(var));
+
+    entry->own(std::move(assign));
+    entry->own(std::move(alloca));
+}
+
+//values of constants do not depend on the function, they are formatted once into the constant pool of the program
 void createConstantValue(const llvm::Value* val, Func* func, Block* block) {
+    //vector constants are written as compound literals
+    if (val->getType()->isVectorTy() && !llvm::isa<llvm::ConstantExpr>(val)) {
+        const auto* constant = llvm::cast<llvm::Constant>(val);
+        auto type = func->getType(val->getType());
+        const auto* VT = static_cast<const VectorType*>(type.get());
+
+        std::string value = "(" + type->toString() + "){";
+        for (unsigned i = 0; i < VT->size; i++) {
+            if (i != 0) {
+                value += ", ";
+            }
+
+            const auto* element = constant->getAggregateElement(i);
+            if (llvm::isa<llvm::UndefValue>(element)) {
+                value += "0";
+            } else if (element->getType()->isIntegerTy(1)) {
+                //elements of masks are 0 or -1
+                value += element->isNullValue() ? "0" : "-1";
+            } else {
+                auto elementValue = dynamic_cast<Value*>(func->getOrCreateExpr(element, block));
+                if (!elementValue) {
+                    throw std::invalid_argument("Unsupported element of vector constant!");
+                }
+                value += elementValue->valueName;
+            }
+        }
+        value += "}";
+
+        func->program->addConstant(val, std::make_unique<Value>(value, std::move(type)), func);
+        return;
+    }
+
     //undefined value is translated as zero, only for experimental purposes (this value cannot occur in LLVM generated from C)
     if (llvm::isa<llvm::UndefValue>(val)) {
-        func->createExpr(val, std::make_unique<Value>("0", func->getType(val->getType())));
+        func->program->addConstant(val, std::make_unique<Value>("0", func->getType(val->getType())), func);
         return;
     }
 
     if (auto CPN = llvm::dyn_cast<llvm::ConstantPointerNull>(val)) {
-        func->createExpr(val, std::make_unique<Value>("0", func->getType(CPN->getType())));
+        func->program->addConstant(val, std::make_unique<Value>("0", func->getType(CPN->getType())), func);
+        return;
+    }
+
+    //address of a block is the address of its label (GNU labels as values)
+    if (auto BA = llvm::dyn_cast<llvm::BlockAddress>(val)) {
+        if (BA->getFunction() != func->function) {
+            throw std::invalid_argument("Address of a block of another function is not supported!");
+        }
+
+        auto* target = func->getBlock(BA->getBasicBlock());
+        func->createExpr(val, std::make_unique<Value>("&&" + target->blockName, func->getType(val->getType())));
         return;
     }
 
@@ -25,15 +99,15 @@ void createConstantValue(const llvm::Value* val, Func* func, Block* block) {
             value = std::to_string(CI->getSExtValue());
         }
 
-        func->createExpr(val, std::make_unique<Value>(value, std::make_unique<IntType>(false)));
+        func->program->addConstant(val, std::make_unique<Value>(value, std::make_unique<IntType>(false)), func);
         return;
     }
 
     if (auto CFP = llvm::dyn_cast<llvm::ConstantFP>(val)) {
         if (CFP->isInfinity()) {
-            func->createExpr(val, std::make_unique<Value>("__builtin_inff ()", std::make_unique<FloatType>()));
+            func->program->addConstant(val, std::make_unique<Value>("__builtin_inff ()", std::make_unique<FloatType>()), func);
         } else if (CFP->isNaN()){
-            func->createExpr(val, std::make_unique<Value>("__builtin_nanf (\"\")", std::make_unique<FloatType>()));
+            func->program->addConstant(val, std::make_unique<Value>("__builtin_nanf (\"\")", std::make_unique<FloatType>()), func);
         } else {
             std::string CFPvalue = std::to_string(CFP->getValueAPF().convertToDouble());
             if (CFPvalue.compare("-nan") == 0) {
@@ -47,13 +121,14 @@ void createConstantValue(const llvm::Value* val, Func* func, Block* block) {
                 }
             }
 
-            func->createExpr(val, std::make_unique<Value>(CFPvalue, std::make_unique<FloatType>()));
+            func->program->addConstant(val, std::make_unique<Value>(CFPvalue, std::make_unique<FloatType>()), func);
         }
         return;
     }
 
     if (auto CE = llvm::dyn_cast<llvm::ConstantExpr>(val)) {
         parseLLVMInstruction(*CE->getAsInstruction(), true, val, func, block);
+        splitLargeConstantExpression(val, func);
     }
 }
 
@@ -3,20 +3,12 @@
 #include "../core/Program.h"
 #include "../core/Func.h"
 #include "../core/Block.h"
+#include "intrinsics.h"
 
 #include <iostream>
 
 static void declareFunc(const llvm::Function* func, Program& program) {
-    auto decl = std::make_unique<Func>(func, &program, true);
-    const llvm::Value* lastValue = nullptr;
-    for (const llvm::Value& arg : func->args()) {
-        lastValue = &arg;
-
-        auto argVal = std::make_unique<Value>(decl->getVarName(), program.getType(arg.getType()));
-
-        decl->createExpr(&arg, std::move(argVal));
-    }
-
+    auto decl = std::make_unique<FuncDecl>(func, program.getType(func->getReturnType()));
     decl->setVarArg(func->isVarArg());
 
     program.addDeclaration(func, std::move(decl));
@@ -26,7 +18,8 @@ void findDeclaredFunctions(const llvm::Module *module, Program& program) {
     for(const llvm::Function& func : module->functions()) {
         if (func.hasName()) {
             if (func.isDeclaration() || llvm::Function::isInternalLinkage(func.getLinkage())) {
-                if (func.getName().str().substr(0, 8) != "llvm.dbg") {
+                //lowered intrinsics are not called as functions
+                if (func.getName().str().substr(0, 8) != "llvm.dbg" && func.getName().str().substr(0, 14) != "llvm.lifetime." && !hasIntrinsicLowering(&func)) {
                     if (!program.isFunctionDeclared(&func)) {
                         declareFunc(&func, program);
                     }
@@ -4,11 +4,18 @@
 #include "constval.h"
 #include "cfunc.h"
 #include "compare.h"
+#include "intrinsics.h"
+#include "../expr/ExprSize.h"
 
+#include <llvm/Config/llvm-config.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
 #include <llvm/Support/Casting.h>
 #include <llvm/IR/GetElementPtrTypeIterator.h>
+#include <llvm/IR/Operator.h>
+
+#include <algorithm>
 
 using CaseHandle = const llvm::SwitchInst::CaseHandleImpl<const llvm::SwitchInst, const llvm::ConstantInt, const llvm::BasicBlock>*;
 
@@ -29,6 +36,117 @@ static void createFuncCallParam(const llvm::Use& param, Func* func, Block* block
     }
 }
 
+//vectors of i1 are masks, their elements are 0 or -1 instead of 0 or 1
+static bool isMaskVector(const llvm::Type* type) {
+    return type->isVectorTy() && type->getScalarType()->isIntegerTy(1);
+}
+
+//an integer vector always has the typedef of its LLVM type, operations that depend on signedness
+//work with the typedef of the other signedness and their result is cast back
+static Expr* castVectorSignedness(Expr* expr, bool unsignedType, Func* func, Block* block) {
+    auto VT = dynamic_cast<VectorType*>(expr->getType());
+    auto IT = VT ? dynamic_cast<IntegerType*>(VT->type.get()) : nullptr;
+    if (!IT || IT->unsignedType == unsignedType) {
+        return expr;
+    }
+
+    return block->own(std::make_unique<CastExpr>(expr, func->program->typeHandler.getVectorType(*VT, unsignedType)));
+}
+
+static Expr* castIntegerSignedness(Expr* expr, bool unsignedType, Block* block) {
+    auto IT = dynamic_cast<IntegerType*>(expr->getType());
+    if (!IT || IT->unsignedType == unsignedType) {
+        return expr;
+    }
+
+    auto type = IT->clone();
+    static_cast<IntegerType*>(type.get())->unsignedType = unsignedType;
+    return block->own(std::make_unique<CastExpr>(expr, std::move(type)));
+}
+
+//vector typedefs are aligned to their size, memory accesses with lower alignment need an unaligned typedef
+static Expr* castToUnalignedVector(Expr* pointer, const llvm::Type* type, unsigned align, Func* func, Block* block) {
+    if (!type->isVectorTy()) {
+        return pointer;
+    }
+
+    auto vectorType = func->getType(type);
+    auto VT = static_cast<VectorType*>(vectorType.get());
+    if (align == 0 || align >= VT->bytes) {
+        return pointer;
+    }
+
+    auto unaligned = func->program->typeHandler.getVectorType(*VT->type, VT->size, VT->bytes, align);
+    return block->own(std::make_unique<CastExpr>(pointer, std::make_unique<PointerType>(std::move(unaligned))));
+}
+
+//accesses aligned above the natural alignment of their type pass the alignment to the C compiler,
+//stack and global variables declare their alignment themselves
+static Expr* assumeAligned(Expr* pointer, const llvm::Instruction& ins, const llvm::Value* llvmPointer, llvm::Type* type, unsigned align, Func* func, Block* block) {
+    const llvm::Value* base = llvmPointer->stripPointerCasts();
+    while (auto GEP = llvm::dyn_cast<llvm::GEPOperator>(base)) {
+        base = GEP->getPointerOperand()->stripPointerCasts();
+    }
+    if (llvm::isa<llvm::AllocaInst>(base) || llvm::isa<llvm::GlobalVariable>(base)) {
+        return pointer;
+    }
+
+    unsigned alignment = TypeHandler::getOverAlignment(type, align, ins.getModule()->getDataLayout());
+    if (!alignment) {
+        return pointer;
+    }
+
+    auto value = std::make_unique<Value>(std::to_string(alignment), std::make_unique<IntType>(false));
+    std::vector<Expr*> params = {pointer, value.get()};
+    block->addValue(std::move(value));
+
+    Expr* call = block->own(std::make_unique<CallExpr>(nullptr, "__builtin_assume_aligned", params, std::make_unique<PointerType>(std::make_unique<VoidType>())));
+    return block->own(std::make_unique<CastExpr>(call, pointer->getType()->clone()));
+}
+
+//ordering of the llvm atomic instruction as an argument of __atomic builtins
+static std::string getMemoryOrder(llvm::AtomicOrdering ordering) {
+    switch (ordering) {
+    case llvm::AtomicOrdering::Acquire:
+        return "__ATOMIC_ACQUIRE";
+    case llvm::AtomicOrdering::Release:
+        return "__ATOMIC_RELEASE";
+    case llvm::AtomicOrdering::AcquireRelease:
+        return "__ATOMIC_ACQ_REL";
+    case llvm::AtomicOrdering::SequentiallyConsistent:
+        return "__ATOMIC_SEQ_CST";
+    default:
+        return "__ATOMIC_RELAXED";
+    }
+}
+
+static Expr* createMemoryOrder(llvm::AtomicOrdering ordering, Block* block) {
+    auto order = std::make_unique<Value>(getMemoryOrder(ordering), std::make_unique<IntType>(false));
+    Expr* ret = order.get();
+    block->addValue(std::move(order));
+    return ret;
+}
+
+//the _n variants of __atomic builtins only accept integers and pointers, other types use the generic builtins
+static bool isAtomicBuiltinType(const llvm::Type* type) {
+    return type->isIntegerTy() || type->isPointerTy();
+}
+
+//result of an atomic operation is stored to a new variable the same way as return value of a call
+static void createAtomicResult(const llvm::Instruction& ins, std::unique_ptr<Expr> expr, Func* func, Block* block) {
+    Expr* rhs = block->own(std::move(expr));
+
+    auto newVariable = std::make_unique<Value>(func->getVarName(), rhs->getType()->clone());
+    auto alloca = std::make_unique<StackAlloc>(newVariable.get());
+    Expr* assign = block->own(std::make_unique<AssignExpr>(newVariable.get(), rhs));
+
+    block->addExpr(alloca.get());
+    block->addExpr(assign);
+
+    func->createExpr(&ins, std::move(newVariable));
+    block->own(std::move(alloca));
+}
+
 static void parseExtractValueInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
     const llvm::ExtractValueInst* EVI = llvm::cast<const llvm::ExtractValueInst>(&ins);
 
@@ -61,20 +179,26 @@ static void parseExtractValueInstruction(const llvm::Instruction& ins, bool isCo
     func->createExpr(isConstExpr ? val : &ins, std::make_unique<ExtractValueExpr>(indices));
 }
 
+//comparison of vectors gives vector of masks with the size of compared elements, it is converted to vector of i1
+static void parseVectorCompare(const llvm::Instruction& ins, const llvm::Value* value, std::unique_ptr<CmpExpr> cmp, Func* func, Block* block) {
+    auto convert = std::make_unique<ConvertVectorExpr>(cmp.get(), func->getType(ins.getType()));
+    block->own(std::move(cmp));
+    func->createExpr(value, std::move(convert));
+}
+
 static void parseFCmpInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    if (func->getExpr(ins.getOperand(0)) == nullptr) {
-        createConstantValue(ins.getOperand(0), func, block);
-    }
-    Expr* val0 = func->getExpr(ins.getOperand(0));
+    Expr* val0 = func->getOrCreateExpr(ins.getOperand(0), block);
 
-    if (func->getExpr(ins.getOperand(1)) == nullptr) {
-        createConstantValue(ins.getOperand(1), func, block);
-    }
-    Expr* val1 = func->getExpr(ins.getOperand(1));
+    Expr* val1 = func->getOrCreateExpr(ins.getOperand(1), block);
 
     auto cmpInst = llvm::cast<const llvm::CmpInst>(&ins);
     const llvm::Value* value = isConstExpr ? val : &ins;
 
+    if (ins.getType()->isVectorTy()) {
+        parseVectorCompare(ins, value, std::make_unique<CmpExpr>(val0, val1, getComparePredicate(cmpInst), false), func, block);
+        return;
+    }
+
     switch(cmpInst->getPredicate()) {
     case llvm::CmpInst::FCMP_FALSE:
         func->createExpr(value, std::make_unique<Value>("0", std::make_unique<IntegerType>("int", false)));
@@ -90,24 +214,52 @@ static void parseFCmpInstruction(const llvm::Instruction& ins, bool isConstExpr,
 }
 
 static void parseICmpInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    if (func->getExpr(ins.getOperand(0)) == nullptr) {
-        createConstantValue(ins.getOperand(0), func, block);
-    }
-    Expr* val0 = func->getExpr(ins.getOperand(0));
+    Expr* val0 = func->getOrCreateExpr(ins.getOperand(0), block);
 
-    if (func->getExpr(ins.getOperand(1)) == nullptr) {
-        createConstantValue(ins.getOperand(1), func, block);
-    }
-    Expr* val1 = func->getExpr(ins.getOperand(1));
+    Expr* val1 = func->getOrCreateExpr(ins.getOperand(1), block);
 
     auto cmpInst = llvm::cast<const llvm::CmpInst>(&ins);
     const llvm::Value* value = isConstExpr ? val : &ins;
 
-    func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, getComparePredicate(cmpInst), isIntegerCompareUnsigned(cmpInst)));
+    if (ins.getType()->isVectorTy() && (cmpInst->isSigned() || cmpInst->isUnsigned())) {
+        val0 = castVectorSignedness(val0, cmpInst->isUnsigned(), func, block);
+        val1 = castVectorSignedness(val1, cmpInst->isUnsigned(), func, block);
+    }
 
+    auto cmp = std::make_unique<CmpExpr>(val0, val1, getComparePredicate(cmpInst), isIntegerCompareUnsigned(cmpInst));
+    if (ins.getType()->isVectorTy()) {
+        parseVectorCompare(ins, value, std::move(cmp), func, block);
+        return;
+    }
+
+    func->createExpr(value, std::move(cmp));
 }
 
 
+static void parseAtomicStore(const llvm::Instruction& ins, Expr* value, Expr* pointer, Func* func, Block* block) {
+    Expr* order = createMemoryOrder(llvm::cast<llvm::StoreInst>(ins).getOrdering(), block);
+    std::string builtin = "__atomic_store_n";
+
+    //the generic builtin takes the stored value through a pointer
+    if (!isAtomicBuiltinType(ins.getOperand(0)->getType())) {
+        auto var = std::make_unique<Value>(func->getVarName(), func->getType(ins.getOperand(0)->getType()));
+        auto alloca = std::make_unique<StackAlloc>(var.get());
+        Expr* assign = block->own(std::make_unique<AssignExpr>(var.get(), value));
+
+        block->addExpr(alloca.get());
+        block->addExpr(assign);
+
+        value = block->own(std::make_unique<RefExpr>(var.get()));
+        builtin = "__atomic_store";
+        block->own(std::move(alloca));
+        block->own(std::move(var));
+    }
+
+    auto call = std::make_unique<CallExpr>(nullptr, builtin, std::vector<Expr*>{pointer, value, order}, std::make_unique<VoidType>());
+    block->addExpr(call.get());
+    func->createExpr(&ins, std::move(call));
+}
+
 static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
     auto type = func->getType(ins.getOperand(0)->getType());
     if (dynamic_cast<PointerType*>(type.get())) {
@@ -138,10 +290,7 @@ static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
     if (isCast) {
         //inline asm with multiple outputs with casts
         if (llvm::ExtractValueInst* EVI = llvm::dyn_cast<llvm::ExtractValueInst>(inst)) {
-            if (!func->getExpr(ins.getOperand(1))) {
-                createConstantValue(ins.getOperand(1), func, block);
-            }
-            Expr* value = func->getExpr(ins.getOperand(1));
+            Expr* value = func->getOrCreateExpr(ins.getOperand(1), block);
             Expr* asmExpr = func->getExpr(EVI->getOperand(0));
 
             if (auto RE = dynamic_cast<RefExpr*>(value)) {
@@ -156,10 +305,7 @@ static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
 
         //inline asm with single output with cast
         if (AsmExpr* AE = dynamic_cast<AsmExpr*>(func->getExpr(inst))) {
-            if (!func->getExpr(ins.getOperand(1))) {
-                createConstantValue(ins.getOperand(1), func, block);
-            }
-            Expr* value = func->getExpr(ins.getOperand(1));
+            Expr* value = func->getOrCreateExpr(ins.getOperand(1), block);
 
             if (auto RE = dynamic_cast<RefExpr*>(value)) {
                 value = RE->expr;
@@ -172,10 +318,7 @@ static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
 
     //inline asm with multiple outputs
     if (llvm::ExtractValueInst* EVI = llvm::dyn_cast<llvm::ExtractValueInst>(ins.getOperand(0))) {
-        if (!func->getExpr(ins.getOperand(1))) {
-            createConstantValue(ins.getOperand(1), func, block);
-        }
-        Expr* value = func->getExpr(ins.getOperand(1));
+        Expr* value = func->getOrCreateExpr(ins.getOperand(1), block);
         Expr* asmExpr = func->getExpr(EVI->getOperand(0));
 
         if (auto RE = dynamic_cast<RefExpr*>(value)) {
@@ -188,25 +331,23 @@ static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
         }
     }
 
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0), func, block);
-    }
-    Expr* val0 = func->getExpr(ins.getOperand(0));
+    Expr* val0 = func->getOrCreateExpr(ins.getOperand(0), block);
 
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1), func, block);
-    }
-    Expr* val1 = func->getExpr(ins.getOperand(1));
+    Expr* val1 = func->getOrCreateExpr(ins.getOperand(1), block);
 
     //storing to NULL
     if (val1->isZero()) {
         auto newCast = std::make_unique<CastExpr>(val1, func->getType(ins.getOperand(1)->getType()));
         val1 = newCast.get();
-        block->casts.push_back(std::move(newCast));
+        block->own(std::move(newCast));
     }
 
-    if (block->derefs.find(val1) == block->derefs.end()) {
-        block->derefs[val1] = std::make_unique<DerefExpr>(val1);
+    val1 = castToUnalignedVector(val1, ins.getOperand(0)->getType(), llvm::cast<llvm::StoreInst>(ins).getAlignment(), func, block);
+    val1 = assumeAligned(val1, ins, ins.getOperand(1), ins.getOperand(0)->getType(), llvm::cast<llvm::StoreInst>(ins).getAlignment(), func, block);
+
+    if (llvm::cast<llvm::StoreInst>(ins).isAtomic()) {
+        parseAtomicStore(ins, val0, val1, func, block);
+        return;
     }
 
     //inline asm with single output
@@ -218,7 +359,7 @@ static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
         return;
     }
     auto v = isConstExpr ? val : &ins;
-    auto assign = std::make_unique<AssignExpr>(block->derefs[val1].get(), val0);
+    auto assign = std::make_unique<AssignExpr>(block->own(std::make_unique<DerefExpr>(val1)), val0);
 
     if (!isConstExpr) {
         block->addExpr(assign.get());
@@ -227,16 +368,51 @@ static void parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
 }
 
 
+static void parseAtomicLoad(const llvm::Instruction& ins, Expr* pointer, Func* func, Block* block) {
+    Expr* order = createMemoryOrder(llvm::cast<llvm::LoadInst>(ins).getOrdering(), block);
+
+    if (isAtomicBuiltinType(ins.getType())) {
+        createAtomicResult(ins, std::make_unique<CallExpr>(nullptr, "__atomic_load_n", std::vector<Expr*>{pointer, order}, func->getType(ins.getType())), func, block);
+        return;
+    }
+
+    //the generic builtin stores the loaded value through a pointer
+    auto var = std::make_unique<Value>(func->getVarName(), func->getType(ins.getType()));
+    auto alloca = std::make_unique<StackAlloc>(var.get());
+    Expr* ref = block->own(std::make_unique<RefExpr>(var.get()));
+    Expr* call = block->own(std::make_unique<CallExpr>(nullptr, "__atomic_load", std::vector<Expr*>{pointer, ref, order}, std::make_unique<VoidType>()));
+
+    block->addExpr(alloca.get());
+    block->addExpr(call);
+
+    func->createExpr(&ins, std::move(var));
+    block->own(std::move(alloca));
+}
+
 static void parseLoadInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
     auto* v = isConstExpr ? val : &ins;
 
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0), func, block);
+    //saved stack pointer is only passed to stackrestore, which has no expression
+    bool isStackRestored = !ins.user_empty() && std::all_of(ins.user_begin(), ins.user_end(), [](const llvm::User* user) {
+        auto call = llvm::dyn_cast<llvm::IntrinsicInst>(user);
+        return call && call->getIntrinsicID() == llvm::Intrinsic::stackrestore;
+    });
+    if (isStackRestored) {
+        return;
+    }
+
+    Expr* pointer = castToUnalignedVector(func->getOrCreateExpr(ins.getOperand(0), block), ins.getType(), llvm::cast<llvm::LoadInst>(ins).getAlignment(), func, block);
+    pointer = assumeAligned(pointer, ins, ins.getOperand(0), ins.getType(), llvm::cast<llvm::LoadInst>(ins).getAlignment(), func, block);
+
+    if (llvm::cast<llvm::LoadInst>(ins).isAtomic()) {
+        parseAtomicLoad(ins, pointer, func, block);
+        return;
     }
 
     //create new variable for every load instruction
-    auto deref = std::make_unique<DerefExpr>(func->getExpr(ins.getOperand(0)));
-    auto var = std::make_unique<Value>(func->getVarName(), deref->getType()->clone());
+    auto deref = std::make_unique<DerefExpr>(pointer);
+    deref->isVolatile = llvm::cast<llvm::LoadInst>(ins).isVolatile();
+    auto var = std::make_unique<Value>(func->getVarName(), ins.getType()->isVectorTy() ? func->getType(ins.getType()) : deref->getType()->clone());
     auto alloca = std::make_unique<StackAlloc>(var.get());
 
     auto assign = std::make_unique<AssignExpr>(var.get(), deref.get());
@@ -246,28 +422,29 @@ static void parseLoadInstruction(const llvm::Instruction& ins, bool isConstExpr,
 
     func->createExpr(v, std::move(var));
 
-    block->loadDerefs.push_back(std::move(deref));
-    block->stores.push_back(std::move(assign));
-    block->allocas.push_back(std::move(alloca));
+    block->own(std::move(deref));
+    block->own(std::move(assign));
+    block->own(std::move(alloca));
 }
 
 static void parseBinaryInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0), func, block);
-    }
     auto* binOp = llvm::cast<const llvm::BinaryOperator>(&ins);
 
-    Expr* val0 = func->getExpr(ins.getOperand(0));
+    Expr* val0 = func->getOrCreateExpr(ins.getOperand(0), block);
 
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1), func, block);
-    }
-    Expr* val1 = func->getExpr(ins.getOperand(1));
+    Expr* val1 = func->getOrCreateExpr(ins.getOperand(1), block);
 
     const llvm::Value* value = isConstExpr ? val : &ins;
 
     bool isUnsigned = !binOp->hasNoSignedWrap();
 
+    bool vectorSigned = ins.getOpcode() == llvm::Instruction::SDiv || ins.getOpcode() == llvm::Instruction::SRem;
+    bool vectorUnsigned = ins.getOpcode() == llvm::Instruction::UDiv || ins.getOpcode() == llvm::Instruction::URem;
+    if (ins.getType()->isVectorTy() && (vectorSigned || vectorUnsigned)) {
+        val0 = castVectorSignedness(val0, vectorUnsigned, func, block);
+        val1 = castVectorSignedness(val1, vectorUnsigned, func, block);
+    }
+
     std::unique_ptr<Expr> expr;
     switch (ins.getOpcode()) {
     case llvm::Instruction::Add:
@@ -310,71 +487,88 @@ static void parseBinaryInstruction(const llvm::Instruction& ins, bool isConstExp
         throw std::invalid_argument("Unsupported binary instruction encountered!");
     }
 
+    if (ins.getType()->isVectorTy() && val0 != func->getExpr(ins.getOperand(0))) {
+        expr = std::make_unique<CastExpr>(block->own(std::move(expr)), func->getType(ins.getType()));
+    }
+
     func->createExpr(value, std::move(expr));
 }
 
 static void parseSwitchInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    std::map<int, Block*> cases;
+    std::vector<std::pair<int64_t, Block*>> cases;
 
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0), func, block);
-    }
-    Expr* cmp = func->getExpr(ins.getOperand(0));
+    Expr* cmp = expectBranch(ins, func->getOrCreateExpr(ins.getOperand(0), block), func, block);
 
     Block* def = func->createBlockIfNotExist(llvm::cast<llvm::BasicBlock>(ins.getOperand(1)));
     const llvm::SwitchInst* switchIns = llvm::cast<const llvm::SwitchInst>(&ins);
 
+    unsigned bitWidth = switchIns->getCondition()->getType()->getIntegerBitWidth();
+    if (bitWidth > 64) {
+        throw std::invalid_argument("Switch on integers wider than 64 bits is not supported!");
+    }
+
+    cases.reserve(switchIns->getNumCases());
     for (const auto& switchCase : switchIns->cases()) {
         CaseHandle caseHandle = static_cast<CaseHandle>(&switchCase);
-        cases[caseHandle->getCaseValue()->getSExtValue()] = func->createBlockIfNotExist(caseHandle->getCaseSuccessor());
+        cases.emplace_back(caseHandle->getCaseValue()->getSExtValue(), func->createBlockIfNotExist(caseHandle->getCaseSuccessor()));
     }
+    std::sort(cases.begin(), cases.end(), [](const std::pair<int64_t, Block*>& a, const std::pair<int64_t, Block*>& b) {
+        return a.first < b.first;
+    });
 
     if (!isConstExpr) {
-        func->createExpr(&ins, std::make_unique<SwitchExpr>(cmp, def, cases));
+        func->createExpr(&ins, std::make_unique<SwitchExpr>(cmp, def, std::move(cases), bitWidth));
         block->addExpr(func->getExpr(&ins));
     } else {
-        func->createExpr(val, std::make_unique<SwitchExpr>(cmp, def, cases));
+        func->createExpr(val, std::make_unique<SwitchExpr>(cmp, def, std::move(cases), bitWidth));
     }
 }
 
-static void parseAsmInst(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    std::string inst;
+static void parseIndirectBrInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    const llvm::Value* value = isConstExpr ? val : &ins;
 
-    switch(ins.getOpcode()) {
-    case llvm::Instruction::Unreachable:
-        inst = "int3";
-        break;
-    case llvm::Instruction::Fence:
-        inst = "fence";
-        break;
-    default:
-        break;
+    func->createExpr(value, std::make_unique<IndirectGotoExpr>(func->getOrCreateExpr(ins.getOperand(0), block)));
+
+    if (!isConstExpr) {
+        block->addExpr(func->getExpr(&ins));
     }
+}
+
+static void parseUnreachableInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    const llvm::Value* value = isConstExpr ? val : &ins;
+
+    func->createExpr(value, std::make_unique<CallExpr>(nullptr, "__builtin_unreachable", std::vector<Expr*>(), std::make_unique<VoidType>()));
 
     if (!isConstExpr) {
-        func->createExpr(&ins, std::make_unique<AsmExpr>(inst, std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), ""));
         block->addExpr(func->getExpr(&ins));
-    } else {
-        func->createExpr(val, std::make_unique<AsmExpr>(inst, std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), ""));
     }
 }
 
 static void parseShiftInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0), func, block);
-    }
-    Expr* val0 = func->getExpr(ins.getOperand(0));
+    Expr* val0 = func->getOrCreateExpr(ins.getOperand(0), block);
 
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1), func, block);
-    }
-    Expr* val1 = func->getExpr(ins.getOperand(1));
+    Expr* val1 = func->getOrCreateExpr(ins.getOperand(1), block);
 
     const llvm::Value* value = isConstExpr ? val : &ins;
 
     auto* binOp = llvm::cast<const llvm::BinaryOperator>(&ins);
     bool isUnsigned = !binOp->hasNoSignedWrap();
 
+    if (ins.getType()->isVectorTy() && ins.getOpcode() != llvm::Instruction::Shl) {
+        val0 = castVectorSignedness(val0, ins.getOpcode() == llvm::Instruction::LShr, func, block);
+        if (val0 != func->getExpr(ins.getOperand(0))) {
+            std::unique_ptr<Expr> shift;
+            if (ins.getOpcode() == llvm::Instruction::LShr) {
+                shift = std::make_unique<LshrExpr>(val0, val1, true);
+            } else {
+                shift = std::make_unique<AshrExpr>(val0, val1, false);
+            }
+            func->createExpr(value, std::make_unique<CastExpr>(shift.get(), func->getType(ins.getType())));
+            block->own(std::move(shift));
+            return;
+        }
+    }
+
     switch (ins.getOpcode()) {
     case llvm::Instruction::Shl:
         func->createExpr(value, std::make_unique<ShlExpr>(val0, val1, isUnsigned));
@@ -383,7 +577,8 @@ static void parseShiftInstruction(const llvm::Instruction& ins, bool isConstExpr
         func->createExpr(value, std::make_unique<LshrExpr>(val0, val1, isUnsigned));
         break;
     case llvm::Instruction::AShr:
-        func->createExpr(value, std::make_unique<AshrExpr>(val0, val1, isUnsigned));
+        //arithmetic shift needs signed operand
+        func->createExpr(value, std::make_unique<AshrExpr>(val0, val1, false));
         break;
     }
 }
@@ -541,6 +736,11 @@ static void parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
             return;
         }
 
+        // lifetime markers only decide the scopes in which local variables are declared
+        if (funcName.compare(0, 14, "llvm.lifetime.") == 0) {
+            return;
+        }
+
         if (funcName.compare("llvm.trap") == 0 || funcName.compare("llvm.debugtrap") == 0) {
             func->createExpr(&ins, std::make_unique<AsmExpr>("int3", std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), ""));
             block->addExpr(func->getExpr(&ins));
@@ -548,7 +748,16 @@ static void parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
         }
 
         if (funcName.compare("llvm.stacksave") == 0 || funcName.compare("llvm.stackrestore") == 0) {
-            func->stackIgnored();
+            if (!block->getTables().stackScopes.count(&ins)) {
+                func->stackIgnored();
+                return;
+            }
+
+            block->addExpr(block->own(std::make_unique<ScopeExpr>(funcName.compare("llvm.stacksave") == 0)));
+            return;
+        }
+
+        if (lowerIntrinsic(*callInst, func, block)) {
             return;
         }
 
@@ -569,14 +778,7 @@ static void parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
             return;
         }
 
-        if (!func->getExpr(callInst->getCalledValue())) {
-            createConstantValue(callInst->getCalledValue(), func, block);
-        }
-
-        if (!func->getExpr(callInst->getCalledValue())) {
-            createConstantValue(callInst->getCalledValue(), func, block);
-        }
-        funcValue = func->getExpr(callInst->getCalledValue());
+        funcValue = func->getOrCreateExpr(callInst->getCalledValue(), block);
     }
 
     int i = 0;
@@ -605,19 +807,26 @@ static void parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
             block->addExpr(func->getExpr(&ins));
         }
     } else {
-        block->callExprMap.push_back(std::make_unique<CallExpr>(funcValue, funcName, params, type->clone()));
+        auto call = std::make_unique<CallExpr>(funcValue, funcName, params, type->clone());
+
+        //only return of the call result can be marked, a void musttail call is written as a plain call
+        if (callInst->isMustTailCall()) {
+            call->isMustTail = true;
+            func->program->hasMustTail = true;
+        }
+        Expr* callExpr = block->own(std::move(call));
 
         auto newVariable = std::make_unique<Value>(func->getVarName(), type->clone());
         auto alloca = std::make_unique<StackAlloc>(newVariable.get());
-        block->callValueMap.push_back(std::make_unique<AssignExpr>(newVariable.get(), block->callExprMap[block->callExprMap.size() - 1].get()));
+        Expr* assign = block->own(std::make_unique<AssignExpr>(newVariable.get(), callExpr));
 
         if (!isConstExpr) {
             block->addExpr(alloca.get());
-            block->addExpr(block->callValueMap[block->callValueMap.size() - 1].get());
+            block->addExpr(assign);
         }
 
         func->createExpr(value, std::move(newVariable));
-        block->allocas.push_back(std::move(alloca));
+        block->own(std::move(alloca));
     }
 }
 
@@ -697,20 +906,20 @@ static void parseInlineASM(const llvm::Instruction& ins, Func* func, Block* bloc
         //creates new variable for every alloca, getelementptr and cast instruction and global variable that inline asm takes as a parameter
         //as inline asm has problem with casts and expressions containing "&" symbol
         if (GI || CI || AI || GV) {
-            block->vars.push_back(std::make_unique<Value>(func->getVarName(), func->getExpr(arg.get())->getType()->clone()));
-            block->stores.push_back(std::make_unique<AssignExpr>(block->vars[block->vars.size() - 1].get(), func->getExpr(arg.get())));
-            args.push_back(block->vars[block->vars.size() - 1].get());
+            Expr* var = block->own(std::make_unique<Value>(func->getVarName(), func->getExpr(arg.get())->getType()->clone()));
+            Expr* assign = block->own(std::make_unique<AssignExpr>(var, func->getExpr(arg.get())));
+            args.push_back(var);
 
-            block->addExpr(block->vars[block->vars.size() - 1].get());
-            block->addExpr(block->stores[block->stores.size() - 1].get());
+            block->addExpr(var);
+            block->addExpr(assign);
         } else if (CE) {
             if (llvm::isa<llvm::GetElementPtrInst>(CE->getAsInstruction())) {
-                block->vars.push_back(std::make_unique<Value>(func->getVarName(), func->getExpr(arg.get())->getType()->clone()));
-                block->stores.push_back(std::make_unique<AssignExpr>(block->vars[block->vars.size() - 1].get(), func->getExpr(arg.get())));
-                args.push_back(block->vars[block->vars.size() - 1].get());
+                Expr* var = block->own(std::make_unique<Value>(func->getVarName(), func->getExpr(arg.get())->getType()->clone()));
+                Expr* assign = block->own(std::make_unique<AssignExpr>(var, func->getExpr(arg.get())));
+                args.push_back(var);
 
-                block->addExpr(block->vars[block->vars.size() - 1].get());
-                block->addExpr(block->stores[block->stores.size() - 1].get());
+                block->addExpr(var);
+                block->addExpr(assign);
             } else {
                 args.push_back(func->getExpr(arg.get()));
             }
@@ -762,11 +971,65 @@ static void parseInlineASM(const llvm::Instruction& ins, Func* func, Block* bloc
     block->addExpr(func->getExpr(&ins));
 }
 
-static void parseCastInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
-    if (func->getExpr(ins.getOperand(0)) == nullptr) {
-        createConstantValue(ins.getOperand(0), func, block);
+static void parseVectorCastInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Expr* expr, Func* func, Block* block) {
+    const llvm::CastInst* CI = llvm::cast<const llvm::CastInst>(&ins);
+    const llvm::Value* value = isConstExpr ? val : &ins;
+    auto type = func->getType(CI->getDestTy());
+
+    //bitcast keeps the bits, which is what cast between vectors of the same size does
+    if (ins.getOpcode() == llvm::Instruction::BitCast) {
+        if (isMaskVector(CI->getSrcTy()) || isMaskVector(CI->getDestTy())) {
+            throw std::invalid_argument("Bitcast of vector of i1 is not supported!");
+        }
+
+        func->createExpr(value, std::make_unique<CastExpr>(expr, std::move(type)));
+        return;
+    }
+
+    auto one = std::make_unique<Value>("1", std::make_unique<IntType>(false));
+    Expr* source = expr;
+
+    if (isMaskVector(CI->getDestTy())) {
+        //trunc to i1 keeps the lowest bit, comparison makes mask of it
+        auto zero = std::make_unique<Value>("0", std::make_unique<IntType>(false));
+        auto bit = std::make_unique<AndExpr>(source, one.get());
+        auto cmp = std::make_unique<CmpExpr>(bit.get(), zero.get(), "!=", true);
+        func->createExpr(value, std::make_unique<ConvertVectorExpr>(cmp.get(), std::move(type)));
+
+        block->own(std::move(cmp));
+        block->own(std::move(bit));
+        block->addValue(std::move(zero));
+        block->addValue(std::move(one));
+        return;
+    }
+
+    bool signedSource = ins.getOpcode() == llvm::Instruction::SExt || ins.getOpcode() == llvm::Instruction::SIToFP;
+    bool unsignedSource = ins.getOpcode() == llvm::Instruction::ZExt || ins.getOpcode() == llvm::Instruction::UIToFP;
+
+    if (isMaskVector(CI->getSrcTy())) {
+        //masks are signed, zext and uitofp take only the lowest bit
+        if (unsignedSource) {
+            auto bit = std::make_unique<AndExpr>(source, one.get());
+            source = bit.get();
+            block->own(std::move(bit));
+            block->addValue(std::move(one));
+        }
+    } else if (signedSource || unsignedSource) {
+        source = castVectorSignedness(source, unsignedSource, func, block);
     }
-    Expr* expr = func->getExpr(ins.getOperand(0));
+
+    if (ins.getOpcode() == llvm::Instruction::FPToSI) {
+        auto convert = std::make_unique<ConvertVectorExpr>(source, func->program->typeHandler.getVectorType(*static_cast<VectorType*>(type.get()), false));
+        func->createExpr(value, std::make_unique<CastExpr>(convert.get(), std::move(type)));
+        block->own(std::move(convert));
+        return;
+    }
+
+    func->createExpr(value, std::make_unique<ConvertVectorExpr>(source, std::move(type)));
+}
+
+static void parseCastInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    Expr* expr = func->getOrCreateExpr(ins.getOperand(0), block);
 
     auto AE = dynamic_cast<AsmExpr*>(expr);
     //operand is used for initializing output in inline asm
@@ -776,6 +1039,29 @@ static void parseCastInstruction(const llvm::Instruction& ins, bool isConstExpr,
 
     const llvm::CastInst* CI = llvm::cast<const llvm::CastInst>(&ins);
 
+    if (CI->getSrcTy()->isVectorTy() || CI->getDestTy()->isVectorTy()) {
+        parseVectorCastInstruction(ins, isConstExpr, val, expr, func, block);
+        return;
+    }
+
+    //C converts according to the signedness of the operand, e.g. unsigned operand of sign extension is zero-extended
+    switch (ins.getOpcode()) {
+    case llvm::Instruction::SExt:
+        if (!CI->getSrcTy()->isIntegerTy(1)) {
+            expr = castIntegerSignedness(expr, false, block);
+        }
+        break;
+    case llvm::Instruction::SIToFP:
+        expr = castIntegerSignedness(expr, false, block);
+        break;
+    case llvm::Instruction::ZExt:
+    case llvm::Instruction::UIToFP:
+        expr = castIntegerSignedness(expr, true, block);
+        break;
+    default:
+        break;
+    }
+
     auto castExpr = std::make_unique<CastExpr>(expr, func->getType(CI->getDestTy()));
 
     if (ins.getOpcode() == llvm::Instruction::FPToUI) {
@@ -793,31 +1079,102 @@ static void parseCastInstruction(const llvm::Instruction& ins, bool isConstExpr,
     func->createExpr(isConstExpr ? val : &ins, std::move(castExpr));
 }
 
+//C has no ?: for vectors, elements are selected by bitwise operations with mask: right ^ ((left ^ right) & mask)
+static void parseVectorSelect(const llvm::SelectInst* SI, const llvm::Value* value, Expr* left, Expr* right, Func* func, Block* block) {
+    Expr* cond = func->getOrCreateExpr(SI->getCondition(), block);
+
+    auto type = func->getType(SI->getType());
+    auto maskType = func->program->typeHandler.getMaskType(*static_cast<VectorType*>(type.get()));
+
+    auto mask = std::make_unique<ConvertVectorExpr>(cond, maskType->clone());
+    auto leftBits = std::make_unique<CastExpr>(left, maskType->clone());
+    auto rightBits = std::make_unique<CastExpr>(right, maskType->clone());
+    auto diff = std::make_unique<XorExpr>(leftBits.get(), rightBits.get());
+    auto selected = std::make_unique<AndExpr>(diff.get(), mask.get());
+    auto blend = std::make_unique<XorExpr>(rightBits.get(), selected.get());
+
+    func->createExpr(value, std::make_unique<CastExpr>(blend.get(), std::move(type)));
+
+    block->own(std::move(mask));
+    block->own(std::move(leftBits));
+    block->own(std::move(rightBits));
+    block->own(std::move(diff));
+    block->own(std::move(selected));
+    block->own(std::move(blend));
+}
+
+static void parseExtractElementInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    Expr* vector = func->getOrCreateExpr(ins.getOperand(0), block);
+
+    Expr* index = func->getOrCreateExpr(ins.getOperand(1), block);
+
+    const llvm::Value* value = isConstExpr ? val : &ins;
+    auto element = std::make_unique<ArrayElement>(vector, index, func->getType(ins.getType()));
+
+    if (isMaskVector(ins.getOperand(0)->getType())) {
+        auto one = std::make_unique<Value>("1", std::make_unique<IntType>(false));
+        func->createExpr(value, std::make_unique<AndExpr>(element.get(), one.get()));
+        block->own(std::move(element));
+        block->addValue(std::move(one));
+        return;
+    }
+
+    func->createExpr(value, std::move(element));
+}
+
+static void parseInsertElementInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    Expr* vector = func->getOrCreateExpr(ins.getOperand(0), block);
+
+    Expr* element = func->getOrCreateExpr(ins.getOperand(1), block);
+
+    Expr* index = func->getOrCreateExpr(ins.getOperand(2), block);
+
+    if (isMaskVector(ins.getType())) {
+        auto zero = std::make_unique<Value>("0", std::make_unique<IntType>(false));
+        auto negation = std::make_unique<SubExpr>(zero.get(), element, false);
+        element = negation.get();
+        block->own(std::move(negation));
+        block->addValue(std::move(zero));
+    }
+
+    func->createExpr(isConstExpr ? val : &ins, std::make_unique<InsertElementExpr>(vector, element, index));
+}
+
+static void parseShuffleVectorInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    const llvm::ShuffleVectorInst* SVI = llvm::cast<const llvm::ShuffleVectorInst>(&ins);
+
+    Expr* left = func->getOrCreateExpr(ins.getOperand(0), block);
+
+    Expr* right = func->getOrCreateExpr(ins.getOperand(1), block);
+
+    llvm::SmallVector<int, 16> mask;
+    SVI->getShuffleMask(mask);
+
+    func->createExpr(isConstExpr ? val : &ins, std::make_unique<ShuffleVectorExpr>(left, right, std::vector<int>(mask.begin(), mask.end()), func->getType(ins.getType())));
+}
+
 static void parseSelectInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
     const llvm::SelectInst* SI = llvm::cast<const llvm::SelectInst>(&ins);
     Expr* cond = func->getExpr(SI->getCondition());
 
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1), func, block);
-    }
-    Expr* val0 = func->getExpr(ins.getOperand(1));
+    Expr* val0 = func->getOrCreateExpr(ins.getOperand(1), block);
 
-    if (!func->getExpr(ins.getOperand(2))) {
-        createConstantValue(ins.getOperand(2), func, block);
-    }
-    Expr* val1 = func->getExpr(ins.getOperand(2));
+    Expr* val1 = func->getOrCreateExpr(ins.getOperand(2), block);
 
     const llvm::Value* value = isConstExpr ? val : &ins;
+
+    if (SI->getCondition()->getType()->isVectorTy()) {
+        parseVectorSelect(SI, value, val0, val1, func, block);
+        return;
+    }
+
     func->createExpr(value, std::make_unique<SelectExpr>(cond, val0, val1));
 }
 
 static void parseGepInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
     const llvm::GetElementPtrInst* gepInst = llvm::cast<llvm::GetElementPtrInst>(&ins);
 
-    if (!func->getExpr(gepInst->getOperand(0))) {
-        createConstantValue(gepInst->getOperand(0), func, block);
-    }
-    Expr* expr = func->getExpr(gepInst->getOperand(0));
+    Expr* expr = func->getOrCreateExpr(gepInst->getOperand(0), block);
 
     llvm::Type* prevType = gepInst->getOperand(0)->getType();
     Expr* prevExpr = expr;
@@ -825,15 +1182,11 @@ static void parseGepInstruction(const llvm::Instruction& ins, bool isConstExpr,
 
     //if getelementptr contains null, cast it to given type
     if (expr->isZero()) {
-        block->casts.push_back(std::make_unique<CastExpr>(expr, func->getType(prevType)));
-        prevExpr = block->casts[block->casts.size() - 1].get();
+        prevExpr = block->own(std::make_unique<CastExpr>(expr, func->getType(prevType)));
     }
 
     for (auto it = llvm::gep_type_begin(gepInst); it != llvm::gep_type_end(gepInst); it++) {
-        if (!func->getExpr(it.getOperand())) {
-            createConstantValue(it.getOperand(), func, block);
-        }
-        Expr* index = func->getExpr(it.getOperand());
+        Expr* index = func->getOrCreateExpr(it.getOperand(), block);
 
         if (prevType->isPointerTy()) {
             if (index->isZero()) {
@@ -859,8 +1212,124 @@ static void parseGepInstruction(const llvm::Instruction& ins, bool isConstExpr,
         prevType = it.getIndexedType();
         prevExpr = indices[indices.size() - 1].get();
     }
-    block->geps.push_back(std::make_unique<GepExpr>(indices));
-    func->createExpr(isConstExpr ? val : &ins, std::make_unique<RefExpr>(block->geps[block->geps.size() -1].get()));
+    func->createExpr(isConstExpr ? val : &ins, std::make_unique<RefExpr>(block->own(std::make_unique<GepExpr>(indices))));
+}
+
+static void parseAtomicRMWInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    const llvm::AtomicRMWInst* RMWI = llvm::cast<const llvm::AtomicRMWInst>(&ins);
+
+    Expr* pointer = func->getOrCreateExpr(RMWI->getPointerOperand(), block);
+
+    Expr* value = func->getOrCreateExpr(RMWI->getValOperand(), block);
+
+    auto type = func->getType(ins.getType());
+    std::string builtin;
+    AtomicRMWExpr::Op op = AtomicRMWExpr::Op::XCHG;
+
+    switch (RMWI->getOperation()) {
+    case llvm::AtomicRMWInst::Xchg:
+        builtin = "__atomic_exchange_n";
+        break;
+    case llvm::AtomicRMWInst::Add:
+        builtin = "__atomic_fetch_add";
+        break;
+    case llvm::AtomicRMWInst::Sub:
+        builtin = "__atomic_fetch_sub";
+        break;
+    case llvm::AtomicRMWInst::And:
+        builtin = "__atomic_fetch_and";
+        break;
+    case llvm::AtomicRMWInst::Nand:
+        builtin = "__atomic_fetch_nand";
+        break;
+    case llvm::AtomicRMWInst::Or:
+        builtin = "__atomic_fetch_or";
+        break;
+    case llvm::AtomicRMWInst::Xor:
+        builtin = "__atomic_fetch_xor";
+        break;
+    case llvm::AtomicRMWInst::Max:
+    case llvm::AtomicRMWInst::UMax:
+        op = AtomicRMWExpr::Op::MAX;
+        break;
+    case llvm::AtomicRMWInst::Min:
+    case llvm::AtomicRMWInst::UMin:
+        op = AtomicRMWExpr::Op::MIN;
+        break;
+#if LLVM_VERSION_MAJOR >= 9
+    case llvm::AtomicRMWInst::FAdd:
+        op = AtomicRMWExpr::Op::FADD;
+        break;
+    case llvm::AtomicRMWInst::FSub:
+        op = AtomicRMWExpr::Op::FSUB;
+        break;
+#endif
+    default:
+        throw std::invalid_argument("Unsupported atomicrmw operation!");
+    }
+
+    if (!builtin.empty() && isAtomicBuiltinType(ins.getType())) {
+        Expr* order = createMemoryOrder(RMWI->getOrdering(), block);
+        createAtomicResult(ins, std::make_unique<CallExpr>(nullptr, builtin, std::vector<Expr*>{pointer, value, order}, std::move(type)), func, block);
+        return;
+    }
+
+    //the loop compares the values in the pointed type, it needs the signedness of the operation
+    if (auto IT = dynamic_cast<IntegerType*>(type.get())) {
+        IT->unsignedType = RMWI->getOperation() != llvm::AtomicRMWInst::Max && RMWI->getOperation() != llvm::AtomicRMWInst::Min;
+        pointer = block->own(std::make_unique<CastExpr>(pointer, std::make_unique<PointerType>(type->clone())));
+    }
+
+    createAtomicResult(ins, std::make_unique<AtomicRMWExpr>(pointer, value, op, getMemoryOrder(RMWI->getOrdering()), std::move(type)), func, block);
+}
+
+static void parseAtomicCmpXchgInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    const llvm::AtomicCmpXchgInst* CXI = llvm::cast<const llvm::AtomicCmpXchgInst>(&ins);
+
+    for (unsigned i = 0; i < 3; i++) {
+        if (!func->getExpr(ins.getOperand(i))) {
+            createConstantValue(ins.getOperand(i), func, block);
+        }
+    }
+
+    //the result {old value, success} is a struct, the builtin writes the old value to its first element
+    auto var = std::make_unique<Value>(func->getVarName(), func->getType(ins.getType()));
+    Struct* strct = func->getStruct(llvm::cast<llvm::StructType>(ins.getType()));
+    auto alloca = std::make_unique<StackAlloc>(var.get());
+
+    Expr* oldValue = block->own(std::make_unique<StructElement>(strct, var.get(), 0));
+    Expr* success = block->own(std::make_unique<StructElement>(strct, var.get(), 1));
+    Expr* expected = block->own(std::make_unique<RefExpr>(oldValue));
+
+    auto weak = std::make_unique<Value>(CXI->isWeak() ? "1" : "0", std::make_unique<IntType>(false));
+    std::vector<Expr*> params = {
+        func->getExpr(CXI->getPointerOperand()),
+        expected,
+        func->getExpr(CXI->getNewValOperand()),
+        weak.get(),
+        createMemoryOrder(CXI->getSuccessOrdering(), block),
+        createMemoryOrder(CXI->getFailureOrdering(), block)
+    };
+    block->addValue(std::move(weak));
+    Expr* call = block->own(std::make_unique<CallExpr>(nullptr, "__atomic_compare_exchange_n", params, success->getType()->clone()));
+
+    block->addExpr(alloca.get());
+    block->addExpr(block->own(std::make_unique<AssignExpr>(oldValue, func->getExpr(CXI->getCompareOperand()))));
+    block->addExpr(block->own(std::make_unique<AssignExpr>(success, call)));
+
+    func->createExpr(&ins, std::move(var));
+    block->own(std::move(alloca));
+}
+
+static void parseFenceInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block* block) {
+    const llvm::FenceInst* FI = llvm::cast<const llvm::FenceInst>(&ins);
+
+    //fence that synchronizes only with the same thread orders against signal handlers
+    std::string builtin = FI->getSyncScopeID() == llvm::SyncScope::SingleThread ? "__atomic_signal_fence" : "__atomic_thread_fence";
+
+    auto call = std::make_unique<CallExpr>(nullptr, builtin, std::vector<Expr*>{createMemoryOrder(FI->getOrdering(), block)}, std::make_unique<VoidType>());
+    block->addExpr(call.get());
+    func->createExpr(&ins, std::move(call));
 }
 
 void parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val, Func* func, Block *block) {
@@ -897,9 +1366,20 @@ void parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr, const
     case llvm::Instruction::Switch:
         parseSwitchInstruction(ins, isConstExpr, val, func, block);
         break;
+    case llvm::Instruction::IndirectBr:
+        parseIndirectBrInstruction(ins, isConstExpr, val, func, block);
+        break;
     case llvm::Instruction::Unreachable:
+        parseUnreachableInstruction(ins, isConstExpr, val, func, block);
+        break;
     case llvm::Instruction::Fence:
-        parseAsmInst(ins, isConstExpr, val, func, block);
+        parseFenceInstruction(ins, isConstExpr, val, func, block);
+        break;
+    case llvm::Instruction::AtomicRMW:
+        parseAtomicRMWInstruction(ins, isConstExpr, val, func, block);
+        break;
+    case llvm::Instruction::AtomicCmpXchg:
+        parseAtomicCmpXchgInstruction(ins, isConstExpr, val, func, block);
         break;
     case llvm::Instruction::Shl:
     case llvm::Instruction::LShr:
@@ -932,6 +1412,15 @@ void parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr, const
     case llvm::Instruction::ExtractValue:
         parseExtractValueInstruction(ins, isConstExpr, val, func, block);
         break;
+    case llvm::Instruction::ExtractElement:
+        parseExtractElementInstruction(ins, isConstExpr, val, func, block);
+        break;
+    case llvm::Instruction::InsertElement:
+        parseInsertElementInstruction(ins, isConstExpr, val, func, block);
+        break;
+    case llvm::Instruction::ShuffleVector:
+        parseShuffleVectorInstruction(ins, isConstExpr, val, func, block);
+        break;
     case llvm::Instruction::Alloca:
         llvm::outs() << "Alloca instructions should be removed by now!\n";
         llvm::outs() << "But this instruction was found: '" << ins << "'\n";
@@ -951,21 +1440,117 @@ void parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr, const
 }
 
 
+//allocation of stack memory whose size is known only at run time
+static void parseDynamicAlloca(const llvm::AllocaInst& ins, Func* func, Block* block) {
+    Expr* count = func->getOrCreateExpr(ins.getArraySize(), block);
+
+    const auto& layout = ins.getModule()->getDataLayout();
+    auto var = std::make_unique<Value>(func->getVarName(), func->getType(ins.getType()));
+    auto alloca = std::make_unique<StackAlloc>(var.get());
+    block->addExpr(alloca.get());
+
+    if (block->getTables().arrayAllocas.count(&ins)) {
+        //memory of the array is freed at the end of its scope, as by stackrestore
+        alloca->count = count;
+        alloca->alignment = TypeHandler::getOverAlignment(ins.getAllocatedType(), ins.getAlignment(), layout);
+    } else {
+        Expr* size = count;
+        uint64_t elementSize = layout.getTypeAllocSize(ins.getAllocatedType());
+        if (elementSize != 1) {
+            Expr* elementValue = block->own(std::make_unique<Value>(std::to_string(elementSize), std::make_unique<IntType>(true)));
+            size = block->own(std::make_unique<MulExpr>(count, elementValue, true));
+        }
+
+        unsigned align = std::max(ins.getAlignment(), layout.getABITypeAlignment(ins.getAllocatedType()));
+        Expr* alignValue = block->own(std::make_unique<Value>(std::to_string(align * 8), std::make_unique<IntType>(true)));
+        Expr* call = block->own(std::make_unique<CallExpr>(nullptr, "__builtin_alloca_with_align", std::vector<Expr*>{size, alignValue}, var->getType()->clone()));
+        block->addExpr(block->own(std::make_unique<AssignExpr>(var.get(), call)));
+    }
+
+    func->createExpr(&ins, std::move(var));
+    block->own(std::move(alloca));
+}
+
+//declarations of temporaries are moved before the scope, their values may be used after it ends
+static void hoistScopedDeclarations(Block* block) {
+    std::vector<Expr*> result;
+    std::vector<Expr*> scoped;
+    int depth = 0;
+
+    for (auto expr : block->expressions) {
+        auto scope = dynamic_cast<ScopeExpr*>(expr);
+        auto decl = dynamic_cast<StackAlloc*>(expr);
+        bool inScope = depth > 0 || scope;
+        if (scope) {
+            depth += scope->isOpening ? 1 : -1;
+        }
+
+        if (!inScope || (decl && !decl->count)) {
+            result.push_back(expr);
+        } else {
+            scoped.push_back(expr);
+        }
+
+        if (scope && depth == 0) {
+            result.insert(result.end(), scoped.begin(), scoped.end());
+            scoped.clear();
+        }
+    }
+
+    block->expressions = result;
+}
+
+//results of long chains of instructions are assigned to temporaries, otherwise they would form one expression
+//too deep for the recursive visitors and C compilers, or exponentially large if values are used more than once
+static void splitLargeExpression(const llvm::Instruction& ins, ExprSize& exprSize, Func* func, Block* block) {
+    Expr* expr = func->getExpr(&ins);
+    if (!expr || dynamic_cast<Value*>(expr) || ins.getType()->isVoidTy() || ins.getType()->isArrayTy()) {
+        return;
+    }
+
+    // every use writes the expression again
+    if (!exprSize.isTooLarge(expr, 0, ins.getNumUses())) {
+        return;
+    }
+
+    block->own(func->releaseExpr(&ins));
+
+    auto var = std::make_unique<Value>(func->getVarName(), expr->getType()->clone());
+    auto alloca = std::make_unique<StackAlloc>(var.get());
+    auto assign = std::make_unique<AssignExpr>(var.get(), expr);
+
+    block->addExpr(alloca.get());
+    block->addExpr(assign.get());
+
+    func->createExpr(&ins, std::move(var));
+
+    block->own(std::move(assign));
+    block->own(std::move(alloca));
+}
+
 void createExpressions(const llvm::Module* module, Program& program) {
     for (const auto& function : module->functions()) {
         auto* func = program.getFunction(&function);
+        ExprSize exprSize;
+
         for (const auto& block : function) {
             auto* myBlock = func->getBlock(&block);
 
             for (const auto& ins : block) {
                 if (ins.getOpcode() != llvm::Instruction::Alloca) {
                     parseLLVMInstruction(ins, false, nullptr, func, myBlock);
+                    splitLargeExpression(ins, exprSize, func, myBlock);
+                } else if (llvm::cast<llvm::AllocaInst>(ins).isArrayAllocation()) {
+                    parseDynamicAlloca(llvm::cast<llvm::AllocaInst>(ins), func, myBlock);
                 } else {
                     // TODO what exactly is this for?
                     func->createExpr(&ins, std::make_unique<RefExpr>(myBlock->getValue(&ins)));
                 }
             }
 
+            if (!myBlock->getTables().stackScopes.empty()) {
+                hoistScopedDeclarations(myBlock);
+            }
         }
     }
 }
@@ -0,0 +1,851 @@
+#include <llvm/IR/Instruction.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "../core/Program.h"
+#include "../core/Func.h"
+#include "../core/Block.h"
+
+#include "../expr/ExprVisitor.h"
+#include "../expr/ExprSize.h"
+
+/*
+ * Temporaries created by load and call instructions are folded into their only use,
+ * e.g. `var1 = *p; x = var1 + 1;` becomes `x = (*p) + 1;`. Volatile loads are never folded.
+ */
+
+// builtins that neither read nor write memory themselves
+static const std::set<std::string> PURE_BUILTINS = {"__builtin_assume_aligned", "__builtin_expect", "__builtin_expect_with_probability"};
+
+struct MemoryEffects {
+    bool reads = false;
+    bool writes = false;
+    bool isVolatile = false; // volatile load, a barrier for all memory accesses
+    // variables that are not in memory, by name as coalesced phi variables share it
+    std::set<std::string> variablesRead;
+    std::set<std::string> variablesWritten;
+
+    static bool intersect(const std::set<std::string>& a, const std::set<std::string>& b) {
+        return std::any_of(a.begin(), a.end(), [&b](const std::string& name) {
+            return b.count(name) > 0;
+        });
+    }
+
+    bool conflictsWith(const MemoryEffects& other) const {
+        return (writes && (other.reads || other.writes)) || (reads && other.writes)
+            || intersect(variablesRead, other.variablesWritten) || intersect(variablesWritten, other.variablesRead);
+    }
+};
+
+/**
+ * @brief The EffectsVisitor computes which memory effects evaluation of an expression has.
+ * Own effects of nodes in @sequencedAfter are ignored (e.g. a call whose argument is being folded
+ * happens only after all its arguments are evaluated).
+ */
+class EffectsVisitor : public ExprVisitor {
+    const std::set<const Value*>& addressable;
+    const std::set<const Expr*>& sequencedAfter;
+
+    void address(Expr* expr);
+    bool ownEffect(const Expr& expr) const;
+
+public:
+    MemoryEffects effects;
+
+    EffectsVisitor(const std::set<const Value*>& addressable, const std::set<const Expr*>& sequencedAfter)
+        : addressable(addressable), sequencedAfter(sequencedAfter) {}
+
+    void visit(StructElement& expr) override;
+    void visit(ArrayElement& expr) override;
+    void visit(ExtractValueExpr& expr) override;
+    void visit(Value& expr) override;
+    void visit(GlobalValue& expr) override;
+    void visit(ScopeExpr& expr) override;
+    void visit(IfExpr& expr) override;
+    void visit(SwitchExpr& expr) override;
+    void visit(AsmExpr& expr) override;
+    void visit(CallExpr& expr) override;
+    void visit(PointerShift& expr) override;
+    void visit(GepExpr& expr) override;
+    void visit(SelectExpr& expr) override;
+    void visit(RefExpr& expr) override;
+    void visit(DerefExpr& expr) override;
+    void visit(RetExpr& expr) override;
+    void visit(IndirectGotoExpr& expr) override;
+    void visit(CastExpr& expr) override;
+    void visit(AddExpr& expr) override;
+    void visit(SubExpr& expr) override;
+    void visit(AssignExpr& expr) override;
+    void visit(MulExpr& expr) override;
+    void visit(DivExpr& expr) override;
+    void visit(RemExpr& expr) override;
+    void visit(AndExpr& expr) override;
+    void visit(OrExpr& expr) override;
+    void visit(XorExpr& expr) override;
+    void visit(CmpExpr& expr) override;
+    void visit(AshrExpr& expr) override;
+    void visit(LshrExpr& expr) override;
+    void visit(ShlExpr& expr) override;
+    void visit(InsertElementExpr& expr) override;
+    void visit(ShuffleVectorExpr& expr) override;
+    void visit(ConvertVectorExpr& expr) override;
+    void visit(AtomicRMWExpr& expr) override;
+    void visit(VectorReduceExpr& expr) override;
+    void visit(StackAlloc& expr) override;
+};
+
+/**
+ * @brief The TempUse struct describes a single occurrence of a temporary in a statement.
+ */
+struct TempUse {
+    Expr* statement;
+    Expr** slot; //pointer to the operand of the parent expression that holds the temporary
+    std::vector<Expr*> ancestors; //path from the statement to the parent of the occurrence
+};
+
+/**
+ * @brief The TempUseVisitor finds all occurrences of temporaries in a statement.
+ */
+class TempUseVisitor : public ExprVisitor {
+    const std::set<Value*>& temporaries;
+    std::map<Value*, std::vector<TempUse>>& uses;
+
+    Expr* statement = nullptr;
+    std::vector<Expr*> ancestors;
+
+    void operand(Expr* parent, Expr*& slot);
+    void nested(Expr* parent, Expr* child);
+
+public:
+    TempUseVisitor(const std::set<Value*>& temporaries, std::map<Value*, std::vector<TempUse>>& uses)
+        : temporaries(temporaries), uses(uses) {}
+
+    void statementUses(Expr* stmt);
+
+    void visit(StructElement& expr) override;
+    void visit(ArrayElement& expr) override;
+    void visit(ExtractValueExpr& expr) override;
+    void visit(IfExpr& expr) override;
+    void visit(SwitchExpr& expr) override;
+    void visit(AsmExpr& expr) override;
+    void visit(CallExpr& expr) override;
+    void visit(PointerShift& expr) override;
+    void visit(GepExpr& expr) override;
+    void visit(SelectExpr& expr) override;
+    void visit(RefExpr& expr) override;
+    void visit(DerefExpr& expr) override;
+    void visit(RetExpr& expr) override;
+    void visit(IndirectGotoExpr& expr) override;
+    void visit(CastExpr& expr) override;
+    void visit(AddExpr& expr) override;
+    void visit(SubExpr& expr) override;
+    void visit(AssignExpr& expr) override;
+    void visit(MulExpr& expr) override;
+    void visit(DivExpr& expr) override;
+    void visit(RemExpr& expr) override;
+    void visit(AndExpr& expr) override;
+    void visit(OrExpr& expr) override;
+    void visit(XorExpr& expr) override;
+    void visit(CmpExpr& expr) override;
+    void visit(AshrExpr& expr) override;
+    void visit(LshrExpr& expr) override;
+    void visit(ShlExpr& expr) override;
+    void visit(InsertElementExpr& expr) override;
+    void visit(ShuffleVectorExpr& expr) override;
+    void visit(ConvertVectorExpr& expr) override;
+    void visit(AtomicRMWExpr& expr) override;
+    void visit(VectorReduceExpr& expr) override;
+    void visit(StackAlloc& expr) override;
+};
+
+static MemoryEffects getEffects(Expr* expr, const std::set<const Value*>& addressable, const std::set<const Expr*>& sequencedAfter = {}) {
+    EffectsVisitor ev(addressable, sequencedAfter);
+    expr->accept(ev);
+    return ev.effects;
+}
+
+static void foldFunctionTemporaries(Func* func) {
+    // variables created for allocas may have their address taken, everything else is a register
+    std::set<const Value*> addressable;
+    // temporaries declared and assigned exactly once within a block
+    std::set<Value*> temporaries;
+    std::map<Value*, AssignExpr*> definitions;
+
+    for (const auto& entry : func->blockMap) {
+        for (const auto& value : entry.second->getTables().valueMap) {
+            addressable.insert(value.second.get());
+        }
+    }
+
+    for (const auto& entry : func->blockMap) {
+        std::set<Value*> declared;
+        for (auto expr : entry.second->expressions) {
+            if (auto SA = dynamic_cast<StackAlloc*>(expr)) {
+                if (!addressable.count(SA->value)) {
+                    declared.insert(SA->value);
+                }
+            } else if (auto AE = dynamic_cast<AssignExpr*>(expr)) {
+                auto var = dynamic_cast<Value*>(AE->left);
+                if (var && declared.count(var)) {
+                    // a second assignment means this is not a temporary
+                    if (!temporaries.insert(var).second) {
+                        temporaries.erase(var);
+                        declared.erase(var);
+                        definitions.erase(var);
+                    } else {
+                        definitions[var] = AE;
+                    }
+                }
+            }
+        }
+    }
+
+    std::map<Value*, std::vector<TempUse>> uses;
+    TempUseVisitor tuv(temporaries, uses);
+    for (const auto& entry : func->blockMap) {
+        for (auto expr : entry.second->expressions) {
+            tuv.statementUses(expr);
+        }
+    }
+
+    for (const auto& entry : func->blockMap) {
+        auto& exprs = entry.second->expressions;
+        std::set<Expr*> removed;
+
+        for (size_t i = 0; i < exprs.size(); ++i) {
+            auto def = dynamic_cast<AssignExpr*>(exprs[i]);
+            if (!def || removed.count(def)) {
+                continue;
+            }
+
+            auto var = dynamic_cast<Value*>(def->left);
+            if (!var || !definitions.count(var) || definitions[var] != def) {
+                continue;
+            }
+
+            const auto& varUses = uses[var];
+            Expr* rhs = def->right;
+            MemoryEffects rhsEffects = getEffects(rhs, addressable);
+
+            // volatile loads stay statements of their own, in the order of the original accesses
+            if (rhsEffects.isVolatile) {
+                continue;
+            }
+
+            auto removeDeclaration = [&exprs, &removed, var]() {
+                for (auto expr : exprs) {
+                    auto SA = dynamic_cast<StackAlloc*>(expr);
+                    if (SA && SA->value == var) {
+                        removed.insert(SA);
+                    }
+                }
+            };
+
+            if (varUses.empty()) {
+                // unused call result, keep only the call itself
+                if (dynamic_cast<CallExpr*>(rhs) || dynamic_cast<AtomicRMWExpr*>(rhs)) {
+                    exprs[i] = rhs;
+                    removeDeclaration();
+                }
+                continue;
+            }
+
+            const TempUse& use = varUses.front();
+            if (varUses.size() != 1 || !use.slot) {
+                continue;
+            }
+
+            // temporaries splitting a large expression stay, the statement is measured as it is now
+            if (ExprSize().isTooLarge(rhs, use.ancestors.size())) {
+                continue;
+            }
+
+            auto useIt = std::find(exprs.begin() + i + 1, exprs.end(), use.statement);
+            if (useIt == exprs.end()) {
+                continue;
+            }
+
+            // nothing between the definition and the use may observe or change the value
+            bool canFold = true;
+            for (auto it = exprs.begin() + i + 1; it != useIt && canFold; ++it) {
+                if (removed.count(*it)) {
+                    continue;
+                }
+                canFold = !rhsEffects.conflictsWith(getEffects(*it, addressable));
+            }
+
+            if (!canFold) {
+                continue;
+            }
+
+            // the rest of the using statement must not be affected either
+            std::set<const Expr*> sequencedAfter;
+            for (auto ancestor : use.ancestors) {
+                if (dynamic_cast<CallExpr*>(ancestor) || dynamic_cast<AsmExpr*>(ancestor)) {
+                    sequencedAfter.insert(ancestor);
+                }
+
+                // a call must not end up in a branch of ?: where it might not be evaluated
+                if (rhsEffects.writes && dynamic_cast<SelectExpr*>(ancestor)) {
+                    canFold = false;
+                }
+            }
+
+            if (auto AE = dynamic_cast<AssignExpr*>(use.statement)) {
+                sequencedAfter.insert(AE);
+            }
+
+            if (!canFold || rhsEffects.conflictsWith(getEffects(use.statement, addressable, sequencedAfter))) {
+                continue;
+            }
+
+            *use.slot = rhs;
+            removed.insert(def);
+            removeDeclaration();
+        }
+
+        exprs.erase(std::remove_if(exprs.begin(), exprs.end(), [&removed](Expr* expr) {
+            return removed.count(expr) > 0;
+        }), exprs.end());
+    }
+}
+
+void foldTemporaries(const llvm::Module* module, Program& program) {
+    for (const llvm::Function& func : module->functions()) {
+        auto* function = program.getFunction(&func);
+        if (function) {
+            foldFunctionTemporaries(function);
+        }
+    }
+}
+
+bool EffectsVisitor::ownEffect(const Expr& expr) const {
+    return !sequencedAfter.count(&expr);
+}
+
+void EffectsVisitor::address(Expr* expr) {
+    // computing an address does not read the addressed memory
+    if (dynamic_cast<Value*>(expr)) {
+        return;
+    }
+
+    if (auto DE = dynamic_cast<DerefExpr*>(expr)) {
+        DE->expr->accept(*this);
+        return;
+    }
+
+    if (auto SE = dynamic_cast<StructElement*>(expr)) {
+        if (dynamic_cast<PointerType*>(SE->expr->getType())) {
+            SE->expr->accept(*this);
+        } else {
+            address(SE->expr);
+        }
+        return;
+    }
+
+    if (auto AE = dynamic_cast<ArrayElement*>(expr)) {
+        address(AE->expr);
+        AE->element->accept(*this);
+        return;
+    }
+
+    if (auto PS = dynamic_cast<PointerShift*>(expr)) {
+        PS->pointer->accept(*this);
+        PS->move->accept(*this);
+        return;
+    }
+
+    if (auto GE = dynamic_cast<GepExpr*>(expr)) {
+        address(GE->indices.back().get());
+        return;
+    }
+
+    expr->accept(*this);
+}
+
+void EffectsVisitor::visit(StructElement& expr) {
+    effects.reads = true;
+    expr.expr->accept(*this);
+}
+
+void EffectsVisitor::visit(ArrayElement& expr) {
+    effects.reads = true;
+    expr.expr->accept(*this);
+    expr.element->accept(*this);
+}
+
+void EffectsVisitor::visit(ExtractValueExpr& expr) {
+    expr.indices.back()->accept(*this);
+}
+
+void EffectsVisitor::visit(Value& expr) {
+    if (addressable.count(&expr)) {
+        effects.reads = true;
+    } else {
+        effects.variablesRead.insert(expr.valueName);
+    }
+}
+
+void EffectsVisitor::visit(GlobalValue& expr) {
+    effects.reads = true;
+}
+
+void EffectsVisitor::visit(ScopeExpr& expr) {
+    // memory of arrays in the scope must not be accessed after it ends
+    effects.reads = true;
+    effects.writes = true;
+}
+
+void EffectsVisitor::visit(IfExpr& expr) {
+    if (expr.cmp) {
+        expr.cmp->accept(*this);
+    }
+
+    for (auto copy : expr.trueCopies) {
+        copy->accept(*this);
+    }
+
+    for (auto copy : expr.falseCopies) {
+        copy->accept(*this);
+    }
+}
+
+void EffectsVisitor::visit(SwitchExpr& expr) {
+    expr.cmp->accept(*this);
+
+    for (const auto& target : expr.copies) {
+        for (auto copy : target.second) {
+            copy->accept(*this);
+        }
+    }
+}
+
+void EffectsVisitor::visit(AsmExpr& expr) {
+    if (ownEffect(expr)) {
+        effects.reads = true;
+        effects.writes = true;
+    }
+
+    for (const auto& out : expr.output) {
+        if (out.second) {
+            address(out.second);
+        }
+    }
+
+    for (const auto& in : expr.input) {
+        in.second->accept(*this);
+    }
+}
+
+void EffectsVisitor::visit(CallExpr& expr) {
+    if (ownEffect(expr) && !PURE_BUILTINS.count(expr.funcName)) {
+        effects.reads = true;
+        effects.writes = true;
+    }
+
+    if (expr.funcValue) {
+        expr.funcValue->accept(*this);
+    }
+
+    for (auto param : expr.params) {
+        param->accept(*this);
+    }
+}
+
+void EffectsVisitor::visit(PointerShift& expr) {
+    effects.reads = true;
+    expr.pointer->accept(*this);
+    expr.move->accept(*this);
+}
+
+void EffectsVisitor::visit(GepExpr& expr) {
+    expr.indices.back()->accept(*this);
+}
+
+void EffectsVisitor::visit(SelectExpr& expr) {
+    expr.comp->accept(*this);
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(RefExpr& expr) {
+    address(expr.expr);
+}
+
+void EffectsVisitor::visit(DerefExpr& expr) {
+    effects.reads = true;
+    if (expr.isVolatile) {
+        effects.writes = true;
+        effects.isVolatile = true;
+    }
+    expr.expr->accept(*this);
+}
+
+void EffectsVisitor::visit(RetExpr& expr) {
+    if (expr.expr) {
+        expr.expr->accept(*this);
+    }
+}
+
+void EffectsVisitor::visit(IndirectGotoExpr& expr) {
+    expr.expr->accept(*this);
+}
+
+void EffectsVisitor::visit(CastExpr& expr) {
+    expr.expr->accept(*this);
+}
+
+void EffectsVisitor::visit(AddExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(SubExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(AssignExpr& expr) {
+    auto var = dynamic_cast<Value*>(expr.left);
+    if (ownEffect(expr)) {
+        if (!var || addressable.count(var) || dynamic_cast<GlobalValue*>(var)) {
+            effects.writes = true;
+        } else {
+            effects.variablesWritten.insert(var->valueName);
+        }
+    }
+
+    address(expr.left);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(MulExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(DivExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(RemExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(AndExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(OrExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(XorExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(CmpExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(AshrExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(LshrExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(ShlExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(InsertElementExpr& expr) {
+    expr.vector->accept(*this);
+    expr.element->accept(*this);
+    expr.index->accept(*this);
+}
+
+void EffectsVisitor::visit(ShuffleVectorExpr& expr) {
+    expr.left->accept(*this);
+    expr.right->accept(*this);
+}
+
+void EffectsVisitor::visit(ConvertVectorExpr& expr) {
+    expr.expr->accept(*this);
+}
+
+void EffectsVisitor::visit(AtomicRMWExpr& expr) {
+    effects.reads = true;
+    effects.writes = true;
+    expr.pointer->accept(*this);
+    expr.value->accept(*this);
+}
+
+void EffectsVisitor::visit(VectorReduceExpr& expr) {
+    expr.vector->accept(*this);
+    if (expr.start) {
+        expr.start->accept(*this);
+    }
+}
+
+void EffectsVisitor::visit(StackAlloc& expr) {
+    if (expr.count) {
+        expr.count->accept(*this);
+    }
+}
+
+void TempUseVisitor::statementUses(Expr* stmt) {
+    statement = stmt;
+    ancestors.clear();
+
+    // a bare variable statement cannot have anything folded into it
+    if (auto var = dynamic_cast<Value*>(stmt)) {
+        if (temporaries.count(var)) {
+            uses[var].push_back(TempUse{stmt, nullptr, {}});
+        }
+        return;
+    }
+
+    stmt->accept(*this);
+}
+
+void TempUseVisitor::operand(Expr* parent, Expr*& slot) {
+    if (auto var = dynamic_cast<Value*>(slot)) {
+        if (temporaries.count(var)) {
+            ancestors.push_back(parent);
+            uses[var].push_back(TempUse{statement, &slot, ancestors});
+            ancestors.pop_back();
+        }
+        return;
+    }
+
+    nested(parent, slot);
+}
+
+void TempUseVisitor::nested(Expr* parent, Expr* child) {
+    ancestors.push_back(parent);
+    child->accept(*this);
+    ancestors.pop_back();
+}
+
+void TempUseVisitor::visit(StructElement& expr) {
+    operand(&expr, expr.expr);
+}
+
+void TempUseVisitor::visit(ArrayElement& expr) {
+    operand(&expr, expr.expr);
+    operand(&expr, expr.element);
+}
+
+void TempUseVisitor::visit(ExtractValueExpr& expr) {
+    nested(&expr, expr.indices.back().get());
+}
+
+void TempUseVisitor::visit(IfExpr& expr) {
+    if (expr.cmp) {
+        operand(&expr, expr.cmp);
+    }
+
+    for (auto copy : expr.trueCopies) {
+        nested(&expr, copy);
+    }
+
+    for (auto copy : expr.falseCopies) {
+        nested(&expr, copy);
+    }
+}
+
+void TempUseVisitor::visit(SwitchExpr& expr) {
+    operand(&expr, expr.cmp);
+
+    for (const auto& target : expr.copies) {
+        for (auto copy : target.second) {
+            nested(&expr, copy);
+        }
+    }
+}
+
+void TempUseVisitor::visit(AsmExpr& expr) {
+    // outputs are written by the asm, they must stay variables
+    for (auto& out : expr.output) {
+        auto var = dynamic_cast<Value*>(out.second);
+        if (var && temporaries.count(var)) {
+            uses[var].push_back(TempUse{statement, nullptr, {}});
+        } else if (out.second) {
+            nested(&expr, out.second);
+        }
+    }
+
+    for (auto& in : expr.input) {
+        operand(&expr, in.second);
+    }
+}
+
+void TempUseVisitor::visit(CallExpr& expr) {
+    if (expr.funcValue) {
+        operand(&expr, expr.funcValue);
+    }
+
+    for (auto& param : expr.params) {
+        operand(&expr, param);
+    }
+}
+
+void TempUseVisitor::visit(PointerShift& expr) {
+    operand(&expr, expr.pointer);
+    operand(&expr, expr.move);
+}
+
+void TempUseVisitor::visit(GepExpr& expr) {
+    nested(&expr, expr.indices.back().get());
+}
+
+void TempUseVisitor::visit(SelectExpr& expr) {
+    operand(&expr, expr.comp);
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(RefExpr& expr) {
+    // the address of a variable is taken, it must stay a variable
+    auto var = dynamic_cast<Value*>(expr.expr);
+    if (var && temporaries.count(var)) {
+        uses[var].push_back(TempUse{statement, nullptr, {}});
+        return;
+    }
+
+    nested(&expr, expr.expr);
+}
+
+void TempUseVisitor::visit(DerefExpr& expr) {
+    operand(&expr, expr.expr);
+}
+
+void TempUseVisitor::visit(RetExpr& expr) {
+    if (expr.expr) {
+        operand(&expr, expr.expr);
+    }
+}
+
+void TempUseVisitor::visit(IndirectGotoExpr& expr) {
+    operand(&expr, expr.expr);
+}
+
+void TempUseVisitor::visit(CastExpr& expr) {
+    operand(&expr, expr.expr);
+}
+
+void TempUseVisitor::visit(AddExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(SubExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(AssignExpr& expr) {
+    // the assignment defining a temporary is not its use
+    auto var = dynamic_cast<Value*>(expr.left);
+    if (!var || !temporaries.count(var)) {
+        operand(&expr, expr.left);
+    }
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(MulExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(DivExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(RemExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(AndExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(OrExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(XorExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(CmpExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(AshrExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(LshrExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(ShlExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(InsertElementExpr& expr) {
+    operand(&expr, expr.vector);
+    operand(&expr, expr.element);
+    operand(&expr, expr.index);
+}
+
+void TempUseVisitor::visit(ShuffleVectorExpr& expr) {
+    operand(&expr, expr.left);
+    operand(&expr, expr.right);
+}
+
+void TempUseVisitor::visit(ConvertVectorExpr& expr) {
+    operand(&expr, expr.expr);
+}
+
+void TempUseVisitor::visit(AtomicRMWExpr& expr) {
+    operand(&expr, expr.pointer);
+    operand(&expr, expr.value);
+}
+
+void TempUseVisitor::visit(VectorReduceExpr& expr) {
+    operand(&expr, expr.vector);
+    if (expr.start) {
+        operand(&expr, expr.start);
+    }
+}
+
+void TempUseVisitor::visit(StackAlloc& expr) {
+    if (expr.count) {
+        operand(&expr, expr.count);
+    }
+}
@@ -6,7 +6,7 @@
 #include <iostream>
 
 static void createArgs(Program& program, const llvm::Function* llvmFunc, Func* func) {
-    const llvm::Value* lastValue;
+    const llvm::Value* lastValue = nullptr;
     for (const llvm::Value& arg : llvmFunc->args()) {
         lastValue = &arg;
         auto argVal = std::make_unique<Value>(func->getVarName(), program.getType(arg.getType()));
@@ -15,12 +15,19 @@ static void createArgs(Program& program, const llvm::Function* llvmFunc, Func* f
         func->createExpr(lastValue, std::move(argVal));
     }
 
-    auto lastArg = func->exprMap[lastValue].get();
+    auto lastArg = lastValue ? func->getExpr(lastValue) : nullptr;
     if (lastArg) {
         func->setVarArg(llvmFunc->isVarArg());
     }
 }
 
+//parameters of declarations are only written in prototypes, they need no expressions
+static void createDeclarationArgs(Program& program, const llvm::Function* llvmFunc, FuncDecl* decl) {
+    for (const llvm::Argument& arg : llvmFunc->args()) {
+        decl->addParameter(std::make_unique<Value>("var" + std::to_string(arg.getArgNo()), program.getType(arg.getType())));
+    }
+}
+
 void createFunctionParameters(const llvm::Module* module, Program& program) {
     for (const llvm::Function& func : module->functions()) {
         auto* myFunc = program.getFunction(&func);
@@ -30,7 +37,7 @@ void createFunctionParameters(const llvm::Module* module, Program& program) {
             createArgs(program, &func, myFunc);
 
         if (decl)
-            createArgs(program, &func, decl);
+            createDeclarationArgs(program, &func, decl);
 
     }
 
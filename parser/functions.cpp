@@ -7,7 +7,7 @@
 void createFunctions(const llvm::Module* module, Program& program) {
     for(const llvm::Function& func : module->functions()) {
         if (func.hasName() && !func.isDeclaration()) {
-            auto newFun = std::make_unique<Func>(&func, &program, false);
+            auto newFun = std::make_unique<Func>(&func, &program);
             program.addFunction(&func, std::move(newFun));
         }
     }
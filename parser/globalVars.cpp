@@ -4,12 +4,55 @@
 
 #include <llvm/IR/Instruction.h>
 
+#include <algorithm>
 #include <regex>
 
 static void parseGlobalVar(const llvm::GlobalVariable& gvar, Program& program);
 
+//function whose blocks are addressed in the initializer, nullptr if there is none
+static const llvm::Function* getBlockAddressFunction(const llvm::Constant* val) {
+    if (auto BA = llvm::dyn_cast<llvm::BlockAddress>(val)) {
+        return BA->getFunction();
+    }
+
+    const llvm::Function* function = nullptr;
+    for (const auto& op : val->operands()) {
+        auto constant = llvm::dyn_cast<llvm::Constant>(op.get());
+        if (!constant || llvm::isa<llvm::GlobalValue>(constant)) {
+            continue;
+        }
+
+        auto opFunction = getBlockAddressFunction(constant);
+        if (function && opFunction && opFunction != function) {
+            throw std::invalid_argument("Addresses of blocks of different functions in one initializer are not supported!");
+        }
+        function = opFunction ? opFunction : function;
+    }
+
+    return function;
+}
+
+static bool isUsedOnlyIn(const llvm::Value* value, const llvm::Function* function) {
+    for (const auto* user : value->users()) {
+        if (auto ins = llvm::dyn_cast<llvm::Instruction>(user)) {
+            if (ins->getFunction() != function) {
+                return false;
+            }
+        } else if (!llvm::isa<llvm::ConstantExpr>(user) || !isUsedOnlyIn(user, function)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static std::string getInitValue(const llvm::Constant* val, Program& program) {
     if (llvm::PointerType* PT = llvm::dyn_cast<llvm::PointerType>(val->getType())) {
+        if (auto BA = llvm::dyn_cast<llvm::BlockAddress>(val)) {
+            auto* func = program.getFunction(BA->getFunction());
+            return "&&" + func->getBlock(BA->getBasicBlock())->blockName;
+        }
+
         std::string name = val->getName().str();
 
         if (llvm::isa<llvm::GlobalVariable>(val)) {
@@ -100,10 +143,10 @@ static std::string getInitValue(const llvm::Constant* val, Program& program) {
         return value + "}";
     }
 
-    if (const llvm::ConstantStruct* CS = llvm::dyn_cast<llvm::ConstantStruct>(val)) {
+    if (llvm::isa<llvm::ConstantStruct>(val) || llvm::isa<llvm::ConstantArray>(val)) {
         std::string value = "{";
         bool first = true;
-        for (unsigned i = 0; i < CS->getNumOperands(); i++) {
+        for (unsigned i = 0; i < val->getNumOperands(); i++) {
             if (!first) {
                 value += ", ";
             }
@@ -140,8 +183,9 @@ static void parseGlobalVar(const llvm::GlobalVariable& gvar, Program& program) {
         program.globalVarNames.insert(gvarName);
     }
 
+    //tables of block addresses are initialized once the blocks are named
     std::string value;
-    if (gvar.hasInitializer()) {
+    if (gvar.hasInitializer() && !getBlockAddressFunction(gvar.getInitializer())) {
         value = getInitValue(gvar.getInitializer(), program);
     }
 
@@ -149,7 +193,33 @@ static void parseGlobalVar(const llvm::GlobalVariable& gvar, Program& program) {
 
     auto var = std::make_unique<GlobalValue>(gvarName, value, program.getType(PT->getElementType()));
     var->getType()->isStatic = gvar.hasInternalLinkage();
+    var->alignment = TypeHandler::getOverAlignment(PT->getElementType(), gvar.getAlignment(), gvar.getParent()->getDataLayout());
 
     program.globalRefs[&gvar] = std::make_unique<RefExpr>(var.get());
     program.globalVars.push_back(std::move(var));
 }
+
+//labels are visible only in their function, so tables of block addresses are its static variables
+void parseBlockAddressTables(const llvm::Module* module, Program& program) {
+    for (const llvm::GlobalVariable& gvar : module->globals()) {
+        const llvm::Function* function = gvar.hasInitializer() ? getBlockAddressFunction(gvar.getInitializer()) : nullptr;
+        if (!function) {
+            continue;
+        }
+
+        if (!isUsedOnlyIn(&gvar, function)) {
+            throw std::invalid_argument("Addresses of blocks used outside of their function are not supported!");
+        }
+
+        auto* var = static_cast<GlobalValue*>(program.getGlobalRef(&gvar)->expr);
+        var->value = getInitValue(gvar.getInitializer(), program);
+        var->getType()->isStatic = true;
+
+        auto& vars = program.globalVars;
+        auto it = std::find_if(vars.begin(), vars.end(), [var](const std::unique_ptr<GlobalValue>& other) {
+            return other.get() == var;
+        });
+        program.getFunction(function)->staticVars.push_back(std::move(*it));
+        vars.erase(it);
+    }
+}
@@ -0,0 +1,547 @@
+#include "intrinsics.h"
+#include "constval.h"
+
+#include "../core/Program.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Metadata.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Calls of LLVM intrinsics that have a C counterpart are translated to GCC builtins
+ * or short expressions, so the C compiler can emit the same instructions.
+ * Intrinsics missing from the table are called as functions named after them.
+ */
+
+enum class LoweringKind {
+    BUILTIN, // call of the builtin chosen by the width of the overloaded type
+    BIT_COUNT, // builtin returning int, the count is cast to the overloaded type
+    COUNT_ZEROS, // __builtin_clz/ctz, the intrinsic may require a defined result for zero
+    OVERFLOW, // __builtin_*_overflow storing the result into the returned struct
+    MIN_MAX,
+    ABS,
+    FUNNEL_SHIFT,
+    PREFETCH,
+    ASSUME, // the condition is turned into undefined behaviour of the C compiler when false
+    VECTOR_REDUCE, // loop over the elements of the vector, the builtins are chosen by the width of the element
+};
+
+struct IntrinsicLowering {
+    LoweringKind kind;
+    std::map<unsigned, std::string> builtins; // width of the overloaded type -> builtin, 0 if the intrinsic is not overloaded
+    std::string op; // comparison of min/max, direction of funnel shift, operator of vector reduction
+    bool isUnsigned;
+};
+
+static std::map<unsigned, std::string> integerBuiltins(const std::string& name) {
+    return {{8, name}, {16, name}, {32, name}, {64, name + "ll"}};
+}
+
+static std::map<unsigned, std::string> floatBuiltins(const std::string& name) {
+    return {{32, name + "f"}, {64, name}, {80, name + "l"}};
+}
+
+static std::map<unsigned, std::string> sameForIntegers(const std::string& name) {
+    return {{8, name}, {16, name}, {32, name}, {64, name}};
+}
+
+static std::map<unsigned, std::string> addBool(std::map<unsigned, std::string> builtins) {
+    builtins[1] = builtins[8];
+    return builtins;
+}
+
+static const std::map<unsigned, std::string> INTEGER_WIDTHS = sameForIntegers("");
+
+static const std::map<unsigned, std::string> FLOAT_WIDTHS = {{32, ""}, {64, ""}};
+
+static const std::map<std::string, IntrinsicLowering> VECTOR_REDUCTIONS = {
+    {"add", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "+", true}},
+    {"mul", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "*", true}},
+    {"and", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "&", true}},
+    {"or", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "|", true}},
+    {"xor", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "^", true}},
+    {"smax", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), ">", false}},
+    {"smin", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "<", false}},
+    {"umax", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), ">", true}},
+    {"umin", {LoweringKind::VECTOR_REDUCE, addBool(INTEGER_WIDTHS), "<", true}},
+    {"fadd", {LoweringKind::VECTOR_REDUCE, FLOAT_WIDTHS, "+", false}},
+    {"fmul", {LoweringKind::VECTOR_REDUCE, FLOAT_WIDTHS, "*", false}},
+    {"fmax", {LoweringKind::VECTOR_REDUCE, floatBuiltins("__builtin_fmax"), "", false}},
+    {"fmin", {LoweringKind::VECTOR_REDUCE, floatBuiltins("__builtin_fmin"), "", false}},
+};
+
+//vector reductions were experimental intrinsics before LLVM 12, fadd and fmul also had the v2 variant
+static const std::vector<std::string> VECTOR_REDUCE_PREFIXES = {"llvm.vector.reduce.", "llvm.experimental.vector.reduce.", "llvm.experimental.vector.reduce.v2."};
+
+static std::map<std::string, IntrinsicLowering> addVectorReductions(std::map<std::string, IntrinsicLowering> intrinsics) {
+    for (const auto& prefix : VECTOR_REDUCE_PREFIXES) {
+        for (const auto& reduction : VECTOR_REDUCTIONS) {
+            intrinsics.emplace(prefix + reduction.first, reduction.second);
+        }
+    }
+    return intrinsics;
+}
+
+static bool isVectorReduction(const std::string& name) {
+    for (const auto& prefix : VECTOR_REDUCE_PREFIXES) {
+        if (name.compare(0, prefix.size(), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static const std::map<std::string, IntrinsicLowering> INTRINSICS = addVectorReductions({
+    {"llvm.ctpop", {LoweringKind::BIT_COUNT, integerBuiltins("__builtin_popcount"), "", true}},
+    {"llvm.bswap", {LoweringKind::BUILTIN, {{16, "__builtin_bswap16"}, {32, "__builtin_bswap32"}, {64, "__builtin_bswap64"}}, "", true}},
+    {"llvm.ctlz", {LoweringKind::COUNT_ZEROS, integerBuiltins("__builtin_clz"), "", true}},
+    {"llvm.cttz", {LoweringKind::COUNT_ZEROS, integerBuiltins("__builtin_ctz"), "", true}},
+    {"llvm.sadd.with.overflow", {LoweringKind::OVERFLOW, sameForIntegers("__builtin_add_overflow"), "", false}},
+    {"llvm.uadd.with.overflow", {LoweringKind::OVERFLOW, sameForIntegers("__builtin_add_overflow"), "", true}},
+    {"llvm.ssub.with.overflow", {LoweringKind::OVERFLOW, sameForIntegers("__builtin_sub_overflow"), "", false}},
+    {"llvm.usub.with.overflow", {LoweringKind::OVERFLOW, sameForIntegers("__builtin_sub_overflow"), "", true}},
+    {"llvm.smul.with.overflow", {LoweringKind::OVERFLOW, sameForIntegers("__builtin_mul_overflow"), "", false}},
+    {"llvm.umul.with.overflow", {LoweringKind::OVERFLOW, sameForIntegers("__builtin_mul_overflow"), "", true}},
+    {"llvm.smax", {LoweringKind::MIN_MAX, INTEGER_WIDTHS, ">", false}},
+    {"llvm.smin", {LoweringKind::MIN_MAX, INTEGER_WIDTHS, "<", false}},
+    {"llvm.umax", {LoweringKind::MIN_MAX, INTEGER_WIDTHS, ">", true}},
+    {"llvm.umin", {LoweringKind::MIN_MAX, INTEGER_WIDTHS, "<", true}},
+    {"llvm.abs", {LoweringKind::ABS, INTEGER_WIDTHS, "", false}},
+    {"llvm.fshl", {LoweringKind::FUNNEL_SHIFT, INTEGER_WIDTHS, "l", true}},
+    {"llvm.fshr", {LoweringKind::FUNNEL_SHIFT, INTEGER_WIDTHS, "r", true}},
+    {"llvm.expect.with.probability", {LoweringKind::BUILTIN, addBool(sameForIntegers("__builtin_expect_with_probability")), "", false}},
+    {"llvm.expect", {LoweringKind::BUILTIN, addBool(sameForIntegers("__builtin_expect")), "", false}},
+    {"llvm.assume", {LoweringKind::ASSUME, {{1, "__builtin_unreachable"}}, "", true}},
+    {"llvm.prefetch", {LoweringKind::PREFETCH, {{0, "__builtin_prefetch"}}, "", true}},
+    {"llvm.sqrt", {LoweringKind::BUILTIN, floatBuiltins("__builtin_sqrt"), "", false}},
+    {"llvm.sin", {LoweringKind::BUILTIN, floatBuiltins("__builtin_sin"), "", false}},
+    {"llvm.cos", {LoweringKind::BUILTIN, floatBuiltins("__builtin_cos"), "", false}},
+    {"llvm.pow", {LoweringKind::BUILTIN, floatBuiltins("__builtin_pow"), "", false}},
+    {"llvm.powi", {LoweringKind::BUILTIN, floatBuiltins("__builtin_powi"), "", false}},
+    {"llvm.exp", {LoweringKind::BUILTIN, floatBuiltins("__builtin_exp"), "", false}},
+    {"llvm.exp2", {LoweringKind::BUILTIN, floatBuiltins("__builtin_exp2"), "", false}},
+    {"llvm.log", {LoweringKind::BUILTIN, floatBuiltins("__builtin_log"), "", false}},
+    {"llvm.log10", {LoweringKind::BUILTIN, floatBuiltins("__builtin_log10"), "", false}},
+    {"llvm.log2", {LoweringKind::BUILTIN, floatBuiltins("__builtin_log2"), "", false}},
+    {"llvm.fma", {LoweringKind::BUILTIN, floatBuiltins("__builtin_fma"), "", false}},
+    {"llvm.fabs", {LoweringKind::BUILTIN, floatBuiltins("__builtin_fabs"), "", false}},
+    {"llvm.minnum", {LoweringKind::BUILTIN, floatBuiltins("__builtin_fmin"), "", false}},
+    {"llvm.maxnum", {LoweringKind::BUILTIN, floatBuiltins("__builtin_fmax"), "", false}},
+    {"llvm.copysign", {LoweringKind::BUILTIN, floatBuiltins("__builtin_copysign"), "", false}},
+    {"llvm.floor", {LoweringKind::BUILTIN, floatBuiltins("__builtin_floor"), "", false}},
+    {"llvm.ceil", {LoweringKind::BUILTIN, floatBuiltins("__builtin_ceil"), "", false}},
+    {"llvm.trunc", {LoweringKind::BUILTIN, floatBuiltins("__builtin_trunc"), "", false}},
+    {"llvm.rint", {LoweringKind::BUILTIN, floatBuiltins("__builtin_rint"), "", false}},
+    {"llvm.nearbyint", {LoweringKind::BUILTIN, floatBuiltins("__builtin_nearbyint"), "", false}},
+    {"llvm.round", {LoweringKind::BUILTIN, floatBuiltins("__builtin_round"), "", false}},
+});
+
+//the table is keyed by the intrinsic name without suffixes of the overloaded types, e.g. llvm.ctpop.i32 -> llvm.ctpop
+static const IntrinsicLowering* findLowering(const llvm::Function* function) {
+    if (!function || !function->isIntrinsic()) {
+        return nullptr;
+    }
+
+    std::string name = function->getName().str();
+    auto it = INTRINSICS.find(name);
+    while (it == INTRINSICS.end()) {
+        auto dot = name.rfind('.');
+        if (dot == std::string::npos) {
+            //there is no C function that a call of the reduction could be kept as
+            if (isVectorReduction(function->getName().str())) {
+                throw std::invalid_argument("Vector reduction " + function->getName().str() + " is not supported!");
+            }
+            return nullptr;
+        }
+        name = name.substr(0, dot);
+        it = INTRINSICS.find(name);
+    }
+
+    const IntrinsicLowering& lowering = it->second;
+    if (lowering.kind == LoweringKind::PREFETCH) {
+        return &lowering;
+    }
+
+    //the vector is the last parameter, fadd and fmul take the start value first
+    if (lowering.kind == LoweringKind::VECTOR_REDUCE) {
+        const auto* type = llvm::cast<llvm::VectorType>(function->getFunctionType()->params().back());
+        if (!lowering.builtins.count(type->getElementType()->getPrimitiveSizeInBits())) {
+            throw std::invalid_argument("Vector reduction " + function->getName().str() + " is not supported for this element type!");
+        }
+        return &lowering;
+    }
+
+    //only scalar overloads are lowered, the width of the first parameter selects the builtin
+    const llvm::Type* type = function->getFunctionType()->getParamType(0);
+    if (type->isVectorTy()) {
+        throw std::invalid_argument("Vector overload " + function->getName().str() + " of the intrinsic is not supported!");
+    }
+    if (!lowering.builtins.count(type->getPrimitiveSizeInBits())) {
+        return nullptr;
+    }
+
+    return &lowering;
+}
+
+bool hasIntrinsicLowering(const llvm::Function* function) {
+    return findLowering(function) != nullptr;
+}
+
+static Expr* getArgument(const llvm::CallInst& call, unsigned i, Func* func, Block* block) {
+    const llvm::Value* arg = call.getArgOperand(i);
+    return func->getOrCreateExpr(arg, block);
+}
+
+static Expr* addExpr(std::unique_ptr<Expr> expr, Block* block) {
+    return block->own(std::move(expr));
+}
+
+static Expr* createValue(const std::string& value, std::unique_ptr<Type> type, Block* block) {
+    auto newValue = std::make_unique<Value>(value, std::move(type));
+    Expr* ret = newValue.get();
+    block->addValue(std::move(newValue));
+    return ret;
+}
+
+static std::unique_ptr<Type> getSignedType(std::unique_ptr<Type> type, bool isUnsigned) {
+    if (auto IT = dynamic_cast<IntegerType*>(type.get())) {
+        IT->unsignedType = isUnsigned;
+    }
+    return type;
+}
+
+static std::unique_ptr<Expr> lowerBuiltin(const llvm::CallInst& call, const std::string& builtin, Func* func, Block* block) {
+    std::vector<Expr*> params;
+    for (unsigned i = 0; i < call.arg_size(); i++) {
+        params.push_back(getArgument(call, i, func, block));
+    }
+
+    return std::make_unique<CallExpr>(nullptr, builtin, params, func->getType(call.getType()));
+}
+
+//narrow integers are computed in int, where they may be sign-extended or, when folded from e.g. a + b,
+//exceed their width. The cast to the unsigned type of the width truncates them.
+static Expr* getTruncatedArgument(const llvm::CallInst& call, unsigned i, Func* func, Block* block) {
+    Expr* value = getArgument(call, i, func, block);
+    const llvm::Type* type = call.getArgOperand(i)->getType();
+    if (type->getPrimitiveSizeInBits() >= 32) {
+        return value;
+    }
+
+    return addExpr(std::make_unique<CastExpr>(value, getSignedType(func->getType(type), true)), block);
+}
+
+//the builtins take unsigned int, the ll variants unsigned long long
+static Expr* getBitCountArgument(const llvm::CallInst& call, const std::string& builtin, Func* func, Block* block) {
+    Expr* value = getTruncatedArgument(call, 0, func, block);
+    bool isLongLong = builtin.compare(builtin.size() - 2, 2, "ll") == 0;
+    auto type = isLongLong ? std::unique_ptr<Type>(std::make_unique<IntegerType>("long long", true)) : std::unique_ptr<Type>(std::make_unique<IntType>(true));
+    return addExpr(std::make_unique<CastExpr>(value, std::move(type)), block);
+}
+
+static std::unique_ptr<Expr> lowerBitCount(const llvm::CallInst& call, const std::string& builtin, Func* func, Block* block) {
+    Expr* count = addExpr(std::make_unique<CallExpr>(nullptr, builtin, std::vector<Expr*>{getBitCountArgument(call, builtin, func, block)}, std::make_unique<IntType>(false)), block);
+    return std::make_unique<CastExpr>(count, func->getType(call.getType()));
+}
+
+static std::unique_ptr<Expr> lowerCountZeros(const llvm::CallInst& call, const std::string& builtin, Func* func, Block* block) {
+    unsigned width = call.getType()->getPrimitiveSizeInBits();
+    auto type = func->getType(call.getType());
+    Expr* value = getBitCountArgument(call, builtin, func, block);
+
+    Expr* count = addExpr(std::make_unique<CallExpr>(nullptr, builtin, std::vector<Expr*>{value}, std::make_unique<IntType>(false)), block);
+
+    //leading zeros of a narrow integer are counted in the zero-extended int
+    if (builtin == "__builtin_clz" && width < 32) {
+        count = addExpr(std::make_unique<SubExpr>(count, createValue(std::to_string(32 - width), std::make_unique<IntType>(false), block), false), block);
+    }
+
+    //the builtins are undefined for zero, the intrinsic returns the width unless its second argument says otherwise
+    auto isZeroPoison = llvm::dyn_cast<llvm::ConstantInt>(call.getArgOperand(1));
+    if (!isZeroPoison || !isZeroPoison->isOne()) {
+        Expr* isNonZero = addExpr(std::make_unique<CmpExpr>(value, createValue("0", value->getType()->clone(), block), "!=", true), block);
+        count = addExpr(std::make_unique<SelectExpr>(isNonZero, count, createValue(std::to_string(width), std::make_unique<IntType>(false), block)), block);
+    }
+
+    return std::make_unique<CastExpr>(count, std::move(type));
+}
+
+static std::unique_ptr<Expr> lowerMinMax(const llvm::CallInst& call, const IntrinsicLowering& lowering, Func* func, Block* block) {
+    Expr* left = getArgument(call, 0, func, block);
+    Expr* right = getArgument(call, 1, func, block);
+
+    Expr* cmp = addExpr(std::make_unique<CmpExpr>(left, right, lowering.op, lowering.isUnsigned), block);
+    return std::make_unique<SelectExpr>(cmp, left, right);
+}
+
+static std::unique_ptr<Expr> lowerAbs(const llvm::CallInst& call, Func* func, Block* block) {
+    auto type = func->getType(call.getType());
+    Expr* value = getArgument(call, 0, func, block);
+    Expr* zero = createValue("0", type->clone(), block);
+
+    //negation is done in unsigned arithmetic, abs of the minimal value stays the same as in LLVM
+    Expr* isNegative = addExpr(std::make_unique<CmpExpr>(value, zero, "<", false), block);
+    Expr* negated = addExpr(std::make_unique<SubExpr>(zero, value, true), block);
+    return std::make_unique<SelectExpr>(isNegative, negated, value);
+}
+
+static std::unique_ptr<Expr> lowerFunnelShift(const llvm::CallInst& call, const IntrinsicLowering& lowering, Func* func, Block* block) {
+    unsigned width = call.getType()->getPrimitiveSizeInBits();
+    auto type = func->getType(call.getType());
+    Expr* high = getTruncatedArgument(call, 0, func, block);
+    Expr* low = call.getArgOperand(0) == call.getArgOperand(1) ? high : getTruncatedArgument(call, 1, func, block);
+    Expr* amount = addExpr(std::make_unique<AndExpr>(getArgument(call, 2, func, block), createValue(std::to_string(width - 1), type->clone(), block)), block);
+    bool isLeft = lowering.op == "l";
+
+    Expr* shifted;
+    Expr* opposite;
+    if (call.getArgOperand(0) == call.getArgOperand(1)) {
+        //rotation, written in the form recognized by C compilers
+        Expr* negated = addExpr(std::make_unique<SubExpr>(createValue("0", type->clone(), block), amount, true), block);
+        Expr* complement = addExpr(std::make_unique<AndExpr>(negated, createValue(std::to_string(width - 1), type->clone(), block)), block);
+        shifted = addExpr(isLeft ? std::unique_ptr<Expr>(std::make_unique<ShlExpr>(high, amount, true))
+                                 : std::unique_ptr<Expr>(std::make_unique<LshrExpr>(low, amount, true)), block);
+        opposite = addExpr(isLeft ? std::unique_ptr<Expr>(std::make_unique<LshrExpr>(low, complement, true))
+                                  : std::unique_ptr<Expr>(std::make_unique<ShlExpr>(high, complement, true)), block);
+    } else {
+        //the opposite shift is split in two, so that it is defined when the amount is zero
+        Expr* complement = addExpr(std::make_unique<SubExpr>(createValue(std::to_string(width - 1), type->clone(), block), amount, true), block);
+        Expr* one = createValue("1", type->clone(), block);
+        if (isLeft) {
+            shifted = addExpr(std::make_unique<ShlExpr>(high, amount, true), block);
+            Expr* halved = addExpr(std::make_unique<LshrExpr>(low, one, true), block);
+            opposite = addExpr(std::make_unique<LshrExpr>(halved, complement, true), block);
+        } else {
+            shifted = addExpr(std::make_unique<LshrExpr>(low, amount, true), block);
+            Expr* doubled = addExpr(std::make_unique<ShlExpr>(high, one, true), block);
+            opposite = addExpr(std::make_unique<ShlExpr>(doubled, complement, true), block);
+        }
+    }
+
+    auto result = std::make_unique<OrExpr>(shifted, opposite);
+    if (width >= 32) {
+        return result;
+    }
+
+    //narrow integers are shifted in int, bits shifted above the width are cut off
+    return std::make_unique<CastExpr>(addExpr(std::move(result), block), std::move(type));
+}
+
+//the result {value, overflow} is a struct, the builtin writes the value to its first element
+static void lowerOverflow(const llvm::CallInst& call, const IntrinsicLowering& lowering, Func* func, Block* block) {
+    auto var = std::make_unique<Value>(func->getVarName(), func->getType(call.getType()));
+    Struct* strct = func->getStruct(llvm::cast<llvm::StructType>(call.getType()));
+    auto alloca = std::make_unique<StackAlloc>(var.get());
+
+    //the builtins compute in infinite precision, operands need the signedness of the intrinsic
+    auto type = getSignedType(func->getType(call.getArgOperand(0)->getType()), lowering.isUnsigned);
+    Expr* left = addExpr(std::make_unique<CastExpr>(getArgument(call, 0, func, block), type->clone()), block);
+    Expr* right = addExpr(std::make_unique<CastExpr>(getArgument(call, 1, func, block), type->clone()), block);
+
+    Expr* result = addExpr(std::make_unique<StructElement>(strct, var.get(), 0), block);
+    Expr* overflow = addExpr(std::make_unique<StructElement>(strct, var.get(), 1), block);
+    Expr* ref = addExpr(std::make_unique<RefExpr>(result), block);
+    Expr* pointer = addExpr(std::make_unique<CastExpr>(ref, std::make_unique<PointerType>(type->clone())), block);
+
+    unsigned width = call.getArgOperand(0)->getType()->getPrimitiveSizeInBits();
+    Expr* builtin = addExpr(std::make_unique<CallExpr>(nullptr, lowering.builtins.at(width), std::vector<Expr*>{left, right, pointer}, overflow->getType()->clone()), block);
+    Expr* assign = block->own(std::make_unique<AssignExpr>(overflow, builtin));
+
+    block->addExpr(alloca.get());
+    block->addExpr(assign);
+
+    func->createExpr(&call, std::move(var));
+    block->own(std::move(alloca));
+}
+
+static void lowerPrefetch(const llvm::CallInst& call, const std::string& builtin, Func* func, Block* block) {
+    //the cache type argument has no counterpart in the builtin
+    std::vector<Expr*> params;
+    for (unsigned i = 0; i < 3; i++) {
+        params.push_back(getArgument(call, i, func, block));
+    }
+
+    auto prefetch = std::make_unique<CallExpr>(nullptr, builtin, params, std::make_unique<VoidType>());
+    block->addExpr(prefetch.get());
+    func->createExpr(&call, std::move(prefetch));
+}
+
+static void lowerAssume(const llvm::CallInst& call, const std::string& builtin, Func* func, Block* block) {
+    //assume(true) only carries operand bundles
+    auto constant = llvm::dyn_cast<llvm::ConstantInt>(call.getArgOperand(0));
+    if (constant && constant->isOne()) {
+        return;
+    }
+
+    //cond ? (void)0 : __builtin_unreachable()
+    Expr* cond = getArgument(call, 0, func, block);
+    Expr* unreachable = addExpr(std::make_unique<CallExpr>(nullptr, builtin, std::vector<Expr*>(), std::make_unique<VoidType>()), block);
+    auto assume = std::make_unique<SelectExpr>(cond, createValue("(void)0", std::make_unique<VoidType>(), block), unreachable);
+
+    block->addExpr(assume.get());
+    func->createExpr(&call, std::move(assume));
+}
+
+//vector of i1 holds 0 and -1, the operations on i1 are reduced to bitwise ones and the result is masked
+static std::string getBoolReduction(const IntrinsicLowering& lowering) {
+    if (lowering.op == "+" || lowering.op == "^") {
+        return "^";
+    }
+    //true is the maximum of unsigned and the minimum of signed i1
+    if (lowering.op == "|" || (lowering.op == ">") == lowering.isUnsigned) {
+        return "|";
+    }
+    return "&";
+}
+
+static std::unique_ptr<Expr> lowerVectorReduce(const llvm::CallInst& call, const IntrinsicLowering& lowering, Func* func, Block* block) {
+    unsigned vectorArg = call.arg_size() - 1;
+    const auto* vectorType = llvm::cast<llvm::VectorType>(call.getArgOperand(vectorArg)->getType());
+    unsigned width = vectorType->getElementType()->getPrimitiveSizeInBits();
+    Expr* vector = getArgument(call, vectorArg, func, block);
+
+    //the start value of the experimental fadd and fmul is ignored when the reduction may be reassociated
+    Expr* start = nullptr;
+    const std::string experimental = "llvm.experimental.vector.reduce.f";
+    bool ignoresStart = call.getCalledFunction()->getName().str().compare(0, experimental.size(), experimental) == 0;
+    if (vectorArg > 0 && !(ignoresStart && call.hasAllowReassoc())) {
+        start = getArgument(call, 0, func, block);
+    }
+
+    if (width == 1) {
+        Expr* reduce = addExpr(std::make_unique<VectorReduceExpr>(vector, nullptr, vectorType->getNumElements(), getBoolReduction(lowering), "", std::make_unique<IntType>(false)), block);
+        Expr* masked = addExpr(std::make_unique<AndExpr>(reduce, createValue("1", std::make_unique<IntType>(false), block)), block);
+        return std::make_unique<CastExpr>(masked, func->getType(call.getType()));
+    }
+
+    //wrapping operations are computed in unsigned, min and max in the signedness of the intrinsic
+    auto type = getSignedType(func->getType(call.getType()), lowering.isUnsigned);
+    Expr* reduce = addExpr(std::make_unique<VectorReduceExpr>(vector, start, vectorType->getNumElements(), lowering.op, lowering.builtins.at(width), std::move(type)), block);
+    return std::make_unique<CastExpr>(reduce, func->getType(call.getType()));
+}
+
+bool lowerIntrinsic(const llvm::CallInst& call, Func* func, Block* block) {
+    const IntrinsicLowering* lowering = findLowering(call.getCalledFunction());
+    if (!lowering) {
+        return false;
+    }
+
+    if (lowering->kind == LoweringKind::VECTOR_REDUCE) {
+        func->createExpr(&call, lowerVectorReduce(call, *lowering, func, block));
+        return true;
+    }
+
+    unsigned width = call.getArgOperand(0)->getType()->getPrimitiveSizeInBits();
+    std::string builtin = lowering->kind == LoweringKind::PREFETCH ? lowering->builtins.at(0) : lowering->builtins.at(width);
+
+    switch (lowering->kind) {
+    case LoweringKind::BUILTIN:
+        func->createExpr(&call, lowerBuiltin(call, builtin, func, block));
+        break;
+    case LoweringKind::BIT_COUNT:
+        func->createExpr(&call, lowerBitCount(call, builtin, func, block));
+        break;
+    case LoweringKind::COUNT_ZEROS:
+        func->createExpr(&call, lowerCountZeros(call, builtin, func, block));
+        break;
+    case LoweringKind::MIN_MAX:
+        func->createExpr(&call, lowerMinMax(call, *lowering, func, block));
+        break;
+    case LoweringKind::ABS:
+        func->createExpr(&call, lowerAbs(call, func, block));
+        break;
+    case LoweringKind::FUNNEL_SHIFT:
+        func->createExpr(&call, lowerFunnelShift(call, *lowering, func, block));
+        break;
+    case LoweringKind::OVERFLOW:
+        lowerOverflow(call, *lowering, func, block);
+        break;
+    case LoweringKind::PREFETCH:
+        lowerPrefetch(call, builtin, func, block);
+        break;
+    case LoweringKind::ASSUME:
+        lowerAssume(call, builtin, func, block);
+        break;
+    case LoweringKind::VECTOR_REDUCE:
+        break;
+    }
+
+    return true;
+}
+
+static std::vector<uint64_t> getBranchWeights(const llvm::Instruction& ins) {
+    std::vector<uint64_t> weights;
+
+    auto prof = ins.getMetadata(llvm::LLVMContext::MD_prof);
+    if (!prof || prof->getNumOperands() != ins.getNumSuccessors() + 1) {
+        return weights;
+    }
+
+    auto name = llvm::dyn_cast<llvm::MDString>(prof->getOperand(0));
+    if (!name || name->getString() != "branch_weights") {
+        return weights;
+    }
+
+    for (unsigned i = 1; i < prof->getNumOperands(); i++) {
+        auto weight = llvm::mdconst::dyn_extract<llvm::ConstantInt>(prof->getOperand(i));
+        if (!weight) {
+            return {};
+        }
+        weights.push_back(weight->getZExtValue());
+    }
+
+    return weights;
+}
+
+Expr* expectBranch(const llvm::Instruction& ins, Expr* cmp, Func* func, Block* block) {
+    auto weights = getBranchWeights(ins);
+
+    uint64_t total = 0;
+    for (auto weight : weights) {
+        total += weight;
+    }
+    if (total == 0) {
+        return cmp;
+    }
+
+    std::string expected;
+    uint64_t weight = 0;
+
+    if (auto switchIns = llvm::dyn_cast<llvm::SwitchInst>(&ins)) {
+        //the switch is expected to take its most likely case, nothing can be said if it is the default
+        for (const auto& switchCase : switchIns->cases()) {
+            unsigned successor = switchCase.getSuccessorIndex();
+            if (weights[successor] > weight) {
+                weight = weights[successor];
+                auto value = switchCase.getCaseValue();
+                auto IT = dynamic_cast<IntegerType*>(cmp->getType());
+                if (IT && IT->unsignedType) {
+                    expected = std::to_string(value->getZExtValue()) + (value->getBitWidth() > 32 ? "ull" : "u");
+                } else {
+                    expected = std::to_string(value->getSExtValue()) + (value->getBitWidth() > 32 ? "ll" : "");
+                }
+            }
+        }
+
+        if (weight <= weights[0]) {
+            return cmp;
+        }
+    } else {
+        //the first weight belongs to the true successor of br
+        expected = "1";
+        weight = weights[0];
+    }
+
+    std::vector<Expr*> params = {
+        cmp,
+        createValue(expected, cmp->getType()->clone(), block),
+        createValue(std::to_string(static_cast<double>(weight) / total), std::make_unique<DoubleType>(), block)
+    };
+
+    return addExpr(std::make_unique<CallExpr>(nullptr, "__builtin_expect_with_probability", params, cmp->getType()->clone()), block);
+}
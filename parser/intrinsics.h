@@ -0,0 +1,32 @@
+#pragma once
+
+#include <llvm/IR/Instructions.h>
+
+#include "../core/Func.h"
+#include "../core/Block.h"
+
+/**
+ * @brief hasIntrinsicLowering Checks whether calls of the LLVM intrinsic are translated to C builtins or expressions.
+ * @param function Called function
+ * @return True if the intrinsic is in the lowering table and its overload is supported, false otherwise
+ */
+bool hasIntrinsicLowering(const llvm::Function* function);
+
+/**
+ * @brief lowerIntrinsic Translates call of an LLVM intrinsic according to the lowering table.
+ * @param call Call of the intrinsic
+ * @param func Function containing the call
+ * @param block Block containing the call
+ * @return True if the call was translated, false if the intrinsic has no lowering
+ */
+bool lowerIntrinsic(const llvm::CallInst& call, Func* func, Block* block);
+
+/**
+ * @brief expectBranch Wraps condition of br or switch in __builtin_expect_with_probability according to its branch_weights metadata.
+ * @param ins Branch instruction
+ * @param cmp Condition of the branch
+ * @param func Function containing the branch
+ * @param block Block containing the branch
+ * @return Wrapped condition, or cmp if the weights give no hint
+ */
+Expr* expectBranch(const llvm::Instruction& ins, Expr* cmp, Func* func, Block* block);
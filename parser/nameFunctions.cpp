@@ -4,7 +4,7 @@
 
 #include <llvm/IR/Instruction.h>
 
-static void nameFunction(const llvm::Function* llvmFunc, Func* func) {
+static void nameFunction(const llvm::Function* llvmFunc, FuncDecl* func) {
     auto name = llvmFunc->getName().str();
 	if (isCFunc(trimPrefix(name))) {
 		name = trimPrefix(name);
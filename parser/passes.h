@@ -10,15 +10,20 @@ void determineIncludes(const llvm::Module* module, Program& program);
 void findMetadataNames(const llvm::Module* module, Program& program);
 void createFunctions(const llvm::Module* module, Program& program);
 void createFunctionParameters(const llvm::Module* module, Program& program);
+void parseFunctionAttributes(const llvm::Module* module, Program& program);
 void createBlocks(const llvm::Module* module, Program& program);
+void parseBlockAddressTables(const llvm::Module* module, Program& program);
 void createAllocas(const llvm::Module* module, Program& program);
 void parseMetadataTypes(const llvm::Module* module, Program& program);
 void createExpressions(const llvm::Module* module, Program& program);
 void findDeclaredFunctions(const llvm::Module* module, Program& program);
 void nameFunctions(const llvm::Module* module, Program& program);
 void parseBreaks(const llvm::Module* module, Program& program);
+void createPhiVariables(const llvm::Module* module, Program& program);
 void addPhis(const llvm::Module* module, Program& program);
-void identifyInlinableBlocks(const llvm::Module* module, Program& program);
 void refDeref(const llvm::Module* mod, Program& program);
 void fixMainParameters(const llvm::Module* module, Program& program);
 void addSignCasts(const llvm::Module* module, Program& program);
+void foldTemporaries(const llvm::Module* module, Program& program);
+void structureBlocks(const llvm::Module* module, Program& program);
+void scopeVariables(const llvm::Module* module, Program& program);
@@ -5,43 +5,460 @@
 #include "constval.h"
 
 #include <llvm/IR/Instruction.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
 
-static void parsePhiInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value *val, Func* func, Block* block) {
-    const llvm::Value* value = isConstExpr ? val : &ins;
-    const auto* phi = llvm::cast<const llvm::PHINode>(&ins);
-    assert(phi != nullptr && "instruction is not a phi node or is null");
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <set>
 
-    // create variable for phi
-    func->createPhiVariable(value);
+/*
+ * Translation out of SSA. Phis and the temporaries flowing into them are coalesced
+ * into a single variable as long as their live ranges do not overlap. Remaining phi
+ * values are assigned on the incoming edges by parallel copies, which are
+ * sequentialized with as few extra variables as possible.
+ *
+ * The target of indirectbr is known only at run time, so the copies for all of its
+ * successors are done before the jump. Phis of these successors therefore keep
+ * variables of their own.
+ *
+ * Expressions other than variables are evaluated where they are used, so a use
+ * of such an expression counts as a use of every variable it reads.
+ */
 
-    // for all incoming blocks:
-    for (auto i = 0; i < phi->getNumIncomingValues(); ++i) {
-        auto* inBlock = phi->getIncomingBlock(i);
-        auto* inValue = phi->getIncomingValue(i);
+// position of phi uses, which happen at the very end of the incoming block
+static const unsigned BLOCK_END = UINT_MAX;
 
-        if (!func->getExpr(inValue)) {
-            createConstantValue(inValue, func, block);
+struct UsePoint {
+    const llvm::BasicBlock* block;
+    unsigned position;
+};
+
+struct Liveness {
+    llvm::DenseSet<const llvm::BasicBlock*> liveIn;
+    llvm::DenseSet<const llvm::BasicBlock*> liveOut;
+    std::vector<UsePoint> uses;
+};
+
+struct PhiCopy {
+    Value* dest;
+    Expr* source;
+    std::set<const Value*> reads; //phi variables read by the source
+};
+
+class PhiEliminator {
+private:
+    Func* func;
+    llvm::DominatorTree domTree;
+
+    llvm::DenseMap<const llvm::Instruction*, unsigned> positions;
+    // declarations of temporaries, which disappear when coalesced
+    llvm::DenseMap<const llvm::Value*, StackAlloc*> temporaries;
+    std::map<const llvm::Value*, std::vector<UsePoint>> usePoints;
+    std::map<const llvm::Value*, Liveness> liveness;
+
+    // congruence classes, every class is represented by one of its phis
+    llvm::DenseMap<const llvm::Value*, const llvm::Value*> classOf;
+    std::map<const llvm::Value*, std::vector<const llvm::Value*>> members;
+
+    bool isCandidate(const llvm::Value* value) const {
+        return llvm::isa<llvm::PHINode>(value) || temporaries.count(value);
+    }
+
+    // the instruction is written wherever it is used instead of being assigned to a variable
+    bool isTree(const llvm::Instruction* ins) const {
+        if (llvm::isa<llvm::PHINode>(ins)) {
+            return false;
         }
+        auto* expr = func->getExpr(ins);
+        return expr && !dynamic_cast<Value*>(expr);
+    }
 
-        // at the end of @inBlock (just before br instruction), append an assignment @value = @inValue
-        auto* myBlock = func->getBlock(inBlock);
-        auto assign = std::make_unique<AssignExpr>(func->getExpr(value), func->getExpr(inValue));
-        myBlock->addExpr(assign.get());
-        myBlock->phiAssignments.push_back(std::move(assign));
+    Value* variable(const llvm::Value* value) const {
+        return static_cast<Value*>(func->getExpr(classOf.lookup(value)));
     }
-}
 
-void addPhis(const llvm::Module* module, Program& program) {
-    for (const auto& function : module->functions()) {
-        auto* func = program.getFunction(&function);
+    UsePoint definition(const llvm::Value* value) const {
+        const auto* ins = llvm::cast<llvm::Instruction>(value);
+        return UsePoint{ins->getParent(), llvm::isa<llvm::PHINode>(ins) ? 0 : positions.lookup(ins)};
+    }
+
+    const std::vector<UsePoint>& getUsePoints(const llvm::Value* value) {
+        auto it = usePoints.find(value);
+        if (it != usePoints.end()) {
+            return it->second;
+        }
+
+        std::vector<UsePoint> result;
+        for (const auto* user : value->users()) {
+            const auto* ins = llvm::dyn_cast<llvm::Instruction>(user);
+            if (!ins) {
+                continue;
+            }
+
+            if (const auto* phi = llvm::dyn_cast<llvm::PHINode>(ins)) {
+                for (unsigned i = 0; i < phi->getNumIncomingValues(); ++i) {
+                    if (phi->getIncomingValue(i) == value) {
+                        result.push_back(UsePoint{phi->getIncomingBlock(i), BLOCK_END});
+                    }
+                }
+            } else if (isTree(ins)) {
+                const auto& nested = getUsePoints(ins);
+                result.insert(result.end(), nested.begin(), nested.end());
+            } else {
+                result.push_back(UsePoint{ins->getParent(), positions.lookup(ins)});
+            }
+        }
+
+        return usePoints[value] = std::move(result);
+    }
+
+    void computeLiveness(const llvm::Value* value) {
+        auto& live = liveness[value];
+        live.uses = getUsePoints(value);
+
+        const auto* defBlock = definition(value).block;
+        std::vector<const llvm::BasicBlock*> worklist;
+        auto markLiveIn = [&](const llvm::BasicBlock* block) {
+            if (block != defBlock && live.liveIn.insert(block).second) {
+                worklist.push_back(block);
+            }
+        };
+
+        for (const auto& use : live.uses) {
+            if (use.position == BLOCK_END) {
+                live.liveOut.insert(use.block);
+            }
+            markLiveIn(use.block);
+        }
+
+        while (!worklist.empty()) {
+            const auto* block = worklist.back();
+            worklist.pop_back();
+            for (const auto* pred : llvm::predecessors(block)) {
+                if (live.liveOut.insert(pred).second) {
+                    markLiveIn(pred);
+                }
+            }
+        }
+    }
+
+    bool isLiveAt(const llvm::Value* value, const UsePoint& point) {
+        const auto& live = liveness[value];
+        if (live.liveOut.count(point.block)) {
+            return true;
+        }
+
+        return std::any_of(live.uses.begin(), live.uses.end(), [&point](const UsePoint& use) {
+            return use.block == point.block && use.position > point.position;
+        });
+    }
+
+    // live ranges in SSA overlap only if one of the values is live at the definition of the other
+    bool interfere(const llvm::Value* a, const llvm::Value* b) {
+        const auto defA = definition(a);
+        const auto defB = definition(b);
+
+        if (defA.block == defB.block) {
+            if (llvm::isa<llvm::PHINode>(a) && llvm::isa<llvm::PHINode>(b)) {
+                return true;
+            }
+            return defA.position < defB.position ? isLiveAt(a, defB) : isLiveAt(b, defA);
+        }
+
+        if (domTree.dominates(defA.block, defB.block)) {
+            return isLiveAt(a, defB);
+        }
+
+        if (domTree.dominates(defB.block, defA.block)) {
+            return isLiveAt(b, defA);
+        }
+
+        return false;
+    }
+
+    static bool isIndirectTarget(const llvm::Value* value) {
+        const auto* phi = llvm::dyn_cast<llvm::PHINode>(value);
+        if (!phi) {
+            return false;
+        }
+
+        const auto* block = phi->getParent();
+        return std::any_of(llvm::pred_begin(block), llvm::pred_end(block), [](const llvm::BasicBlock* pred) {
+            return llvm::isa<llvm::IndirectBrInst>(pred->getTerminator());
+        });
+    }
+
+    void tryCoalesce(const llvm::Value* phi, const llvm::Value* value) {
+        if (isIndirectTarget(phi) || isIndirectTarget(value)) {
+            return;
+        }
+
+        const auto* phiClass = classOf.lookup(phi);
+        const auto* valueClass = classOf.lookup(value);
+        if (phiClass == valueClass) {
+            return;
+        }
+
+        for (const auto* a : members[phiClass]) {
+            for (const auto* b : members[valueClass]) {
+                if (interfere(a, b)) {
+                    return;
+                }
+            }
+        }
+
+        auto& merged = members[phiClass];
+        for (const auto* member : members[valueClass]) {
+            classOf[member] = phiClass;
+            merged.push_back(member);
+        }
+        members.erase(valueClass);
+    }
+
+    // every member of a class becomes the variable of its representative
+    void renameMembers() {
+        for (const auto& entry : members) {
+            auto* var = static_cast<Value*>(func->getExpr(entry.first));
+
+            for (const auto* member : entry.second) {
+                if (member == entry.first) {
+                    continue;
+                }
+
+                auto* memberVar = static_cast<Value*>(func->getExpr(member));
+                memberVar->valueName = var->valueName;
+                memberVar->setType(var->getType()->clone());
+
+                if (llvm::isa<llvm::PHINode>(member)) {
+                    auto& vars = func->phiVariables;
+                    vars.erase(std::remove(vars.begin(), vars.end(), memberVar), vars.end());
+                } else {
+                    auto* decl = temporaries.lookup(member);
+                    auto& exprs = func->getBlock(llvm::cast<llvm::Instruction>(member)->getParent())->expressions;
+                    exprs.erase(std::remove(exprs.begin(), exprs.end(), decl), exprs.end());
+                }
+            }
+        }
+    }
+
+    void collectReads(const llvm::Value* value, std::set<const Value*>& reads) const {
+        if (isCandidate(value)) {
+            reads.insert(variable(value));
+            return;
+        }
+
+        const auto* ins = llvm::dyn_cast<llvm::Instruction>(value);
+        if (ins && isTree(ins)) {
+            for (const auto& op : ins->operands()) {
+                collectReads(op.get(), reads);
+            }
+        }
+    }
+
+    Expr* assign(Block* block, Expr* dest, Expr* source) const {
+        auto assignment = std::make_unique<AssignExpr>(dest, source);
+        auto* result = assignment.get();
+        block->own(std::move(assignment));
+        return result;
+    }
+
+    // orders the copies so that no variable is overwritten before all copies read it
+    std::vector<Expr*> sequentialize(std::vector<PhiCopy> copies, Block* block) {
+        std::vector<Expr*> result;
+
+        auto readers = [&copies](const PhiCopy& copy) {
+            return std::count_if(copies.begin(), copies.end(), [&copy](const PhiCopy& other) {
+                return &other != &copy && other.reads.count(copy.dest);
+            });
+        };
+
+        while (!copies.empty()) {
+            auto next = std::min_element(copies.begin(), copies.end(), [&readers](const PhiCopy& a, const PhiCopy& b) {
+                return readers(a) < readers(b);
+            });
+
+            // a cycle, sources reading the variable are evaluated into new variables first
+            if (readers(*next) > 0) {
+                for (auto& copy : copies) {
+                    if (&copy == &*next || !copy.reads.count(next->dest)) {
+                        continue;
+                    }
+
+                    auto temp = std::make_unique<Value>(func->getVarName(), copy.dest->getType()->clone());
+                    func->phiVariables.push_back(temp.get());
+                    result.push_back(assign(block, temp.get(), copy.source));
+
+                    copy.source = temp.get();
+                    copy.reads.clear();
+                    block->addValue(std::move(temp));
+                }
+            }
+
+            result.push_back(assign(block, next->dest, next->source));
+            copies.erase(next);
+        }
+
+        return result;
+    }
+
+    void collectCopies(const llvm::BasicBlock* pred, const llvm::BasicBlock* block, std::vector<PhiCopy>& copies) {
+        auto* myBlock = func->getBlock(block);
+
+        for (const auto& phi : block->phis()) {
+            const auto* inValue = phi.getIncomingValueForBlock(pred);
+            if (llvm::isa<llvm::UndefValue>(inValue) || (isCandidate(inValue) && classOf.lookup(inValue) == classOf.lookup(&phi))) {
+                continue;
+            }
+
+            PhiCopy copy{variable(&phi), func->getOrCreateExpr(inValue, myBlock), {}};
+            collectReads(inValue, copy.reads);
+            copies.push_back(copy);
+        }
+    }
+
+    void addCopies(const llvm::BasicBlock* pred, const llvm::BasicBlock* block) {
+        auto* myPred = func->getBlock(pred);
+        auto* myBlock = func->getBlock(block);
+
+        std::vector<PhiCopy> copies;
+        collectCopies(pred, block, copies);
+        auto sequence = sequentialize(copies, myPred);
+
+        auto* terminator = myPred->expressions.empty() ? nullptr : myPred->expressions.back();
+        if (auto* ifExpr = dynamic_cast<IfExpr*>(terminator)) {
+            if (ifExpr->trueBlock == myBlock) {
+                ifExpr->trueCopies = sequence;
+            }
+            if (ifExpr->cmp && ifExpr->falseBlock == myBlock) {
+                ifExpr->falseCopies = sequence;
+            }
+        } else if (auto* switchExpr = dynamic_cast<SwitchExpr*>(terminator)) {
+            switchExpr->copies[myBlock] = sequence;
+        } else {
+            myPred->expressions.insert(myPred->expressions.end(), sequence.begin(), sequence.end());
+        }
+    }
+
+    // copies for all successors of indirectbr, placed before the jump
+    void addIndirectCopies(const llvm::BasicBlock* pred) {
+        std::vector<PhiCopy> copies;
+        std::set<const llvm::BasicBlock*> succs(llvm::succ_begin(pred), llvm::succ_end(pred));
+        for (const auto* succ : succs) {
+            for (const auto& phi : succ->phis()) {
+                // a phi is overwritten even if its block is not the one jumped to
+                for (const auto* other : succs) {
+                    if (liveness[&phi].liveIn.count(other)) {
+                        throw std::invalid_argument("Phi value live across indirectbr is not supported!");
+                    }
+                }
+            }
+
+            collectCopies(pred, succ, copies);
+        }
+
+        auto* myPred = func->getBlock(pred);
+        auto sequence = sequentialize(copies, myPred);
+        auto& exprs = myPred->expressions;
+        exprs.insert(exprs.end() - 1, sequence.begin(), sequence.end());
+    }
+
+public:
+    PhiEliminator(Func* func, llvm::Function& function)
+        : func(func), domTree(function) { }
+
+    void run(llvm::Function& function) {
         for (const auto& block : function) {
             auto* myBlock = func->getBlock(&block);
+            unsigned position = 0;
+            for (const auto& ins : block) {
+                positions[&ins] = position++;
+            }
+
+            llvm::DenseMap<const Expr*, StackAlloc*> decls;
+            for (auto* expr : myBlock->expressions) {
+                auto* decl = dynamic_cast<StackAlloc*>(expr);
+                if (decl && !decl->count) {
+                    decls[decl->value] = decl;
+                }
+            }
 
+            for (const auto& ins : block) {
+                if (auto* decl = decls.lookup(func->getExpr(&ins))) {
+                    temporaries[&ins] = decl;
+                }
+            }
+        }
+
+        for (const auto& block : function) {
+            for (const auto& ins : block) {
+                if (isCandidate(&ins)) {
+                    computeLiveness(&ins);
+                    classOf[&ins] = &ins;
+                    members[&ins].push_back(&ins);
+                }
+            }
+        }
+
+        for (const auto& block : function) {
+            for (const auto& phi : block.phis()) {
+                for (const auto& inValue : phi.incoming_values()) {
+                    if (isCandidate(inValue.get())) {
+                        tryCoalesce(&phi, inValue.get());
+                    }
+                }
+            }
+        }
+
+        renameMembers();
+
+        for (const auto& block : function) {
+            if (!llvm::isa<llvm::PHINode>(block.front())) {
+                continue;
+            }
+
+            std::set<const llvm::BasicBlock*> preds(llvm::pred_begin(&block), llvm::pred_end(&block));
+            for (const auto* pred : preds) {
+                if (!llvm::isa<llvm::IndirectBrInst>(pred->getTerminator())) {
+                    addCopies(pred, &block);
+                }
+            }
+        }
+
+        for (const auto& block : function) {
+            if (llvm::isa<llvm::IndirectBrInst>(block.getTerminator())) {
+                addIndirectCopies(&block);
+            }
+        }
+    }
+};
+
+void createPhiVariables(const llvm::Module* module, Program& program) {
+    for (const auto& function : module->functions()) {
+        auto* func = program.getFunction(&function);
+        for (const auto& block : function) {
             for (const auto& ins : block) {
                 if (ins.getOpcode() == llvm::Instruction::PHI) {
-                    parsePhiInstruction(ins, false, nullptr, func, myBlock);
+                    func->createPhiVariable(&ins);
                 }
             }
         }
     }
 }
+
+void addPhis(const llvm::Module* module, Program& program) {
+    for (const auto& function : module->functions()) {
+        auto* func = program.getFunction(&function);
+        if (!func || function.isDeclaration()) {
+            continue;
+        }
+
+        // the analysis only reads the function, but it is not const-correct
+        auto& mutableFunction = const_cast<llvm::Function&>(function);
+        PhiEliminator eliminator(func, mutableFunction);
+        eliminator.run(mutableFunction);
+    }
+}
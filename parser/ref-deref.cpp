@@ -4,40 +4,16 @@
 #include "../core/Func.h"
 #include "../core/Block.h"
 
-#include "../expr/ExprVisitor.h"
+#include "../expr/StaticExprVisitor.h"
 
-class RefDerefVisitor : public ExprVisitor {
+class RefDerefVisitor : public StaticExprVisitor<RefDerefVisitor> {
 
     Expr* simplify(Expr* expr);
 public:
-    void visit(StructElement& expr) override;
-    void visit(ArrayElement& expr) override;
-    void visit(ExtractValueExpr& expr) override;
-    void visit(IfExpr& expr) override;
-    void visit(SwitchExpr& expr) override;
-    void visit(AsmExpr& expr) override;
-    void visit(CallExpr& expr) override;
-    void visit(PointerShift& expr) override;
-    void visit(GepExpr& expr) override;
-    void visit(SelectExpr& expr) override;
-    void visit(RefExpr& expr) override;
-    void visit(DerefExpr& expr) override;
-    void visit(RetExpr& expr) override;
-    void visit(CastExpr& expr) override;
-    void visit(AddExpr& expr) override;
-    void visit(SubExpr& expr) override;
-    void visit(AssignExpr& expr) override;
-    void visit(MulExpr& expr) override;
-    void visit(DivExpr& expr) override;
-    void visit(RemExpr& expr) override;
-    void visit(AndExpr& expr) override;
-    void visit(OrExpr& expr) override;
-    void visit(XorExpr& expr) override;
-    void visit(CmpExpr& expr) override;
-    void visit(AshrExpr& expr) override;
-    void visit(LshrExpr& expr) override;
-    void visit(ShlExpr& expr) override;
+    void visitOperand(Expr*& operand);
 
+    // operands of inline asm are bound to its constraints, they are kept as they are
+    void visitAsmExpr(AsmExpr& expr) { }
 };
 
 void refDeref(const llvm::Module* module, Program& program) {
@@ -50,7 +26,7 @@ void refDeref(const llvm::Module* module, Program& program) {
 
             for (auto it = myBlock->expressions.begin(); it != myBlock->expressions.end(); ++it) {
                 auto expr = *it;
-                expr->accept(rdv);
+                rdv.visit(expr);
 
             }
         }
@@ -58,213 +34,26 @@ void refDeref(const llvm::Module* module, Program& program) {
 }
 
 Expr* RefDerefVisitor::simplify(Expr* expr) {
-    if (auto RE = dynamic_cast<RefExpr*>(expr)) {
-        if (auto DE = dynamic_cast<DerefExpr*>(RE->expr)) {
-            return DE->expr;
+    if (expr->kind == ExprKind::RefExpr) {
+        auto RE = static_cast<RefExpr*>(expr);
+        if (RE->expr->kind == ExprKind::DerefExpr) {
+            return static_cast<DerefExpr*>(RE->expr)->expr;
         }
     }
 
-    if (auto DE = dynamic_cast<DerefExpr*>(expr)) {
-        if (auto RE = dynamic_cast<RefExpr*>(DE->expr)) {
-            return RE->expr;
+    if (expr->kind == ExprKind::DerefExpr) {
+        auto DE = static_cast<DerefExpr*>(expr);
+        if (DE->expr->kind == ExprKind::RefExpr) {
+            return static_cast<RefExpr*>(DE->expr)->expr;
         }
     }
 
     return expr;
 }
 
-void RefDerefVisitor::visit(StructElement& expr) {
-    expr.expr->accept(*this);
-    expr.expr = simplify(expr.expr);
-}
-
-void RefDerefVisitor::visit(ArrayElement& ae) {
-    ae.expr->accept(*this);
-    ae.element->accept(*this);
-
-    ae.expr = simplify(ae.expr);
-    ae.element = simplify(ae.element);
-}
-
-void RefDerefVisitor::visit(ExtractValueExpr& expr) {
-    for (auto& index : expr.indices) {
-        index->accept(*this);
+void RefDerefVisitor::visitOperand(Expr*& operand) {
+    if (operand) {
+        visit(operand);
+        operand = simplify(operand);
     }
 }
-
-void RefDerefVisitor::visit(IfExpr& ifExpr) {
-    if (ifExpr.cmp) {
-        ifExpr.cmp->accept(*this);
-        ifExpr.cmp = simplify(ifExpr.cmp);
-    }
-}
-
-void RefDerefVisitor::visit(SwitchExpr& expr) {
-    expr.cmp->accept(*this);
-    expr.cmp = simplify(expr.cmp);
-}
-
-void RefDerefVisitor::visit(AsmExpr& expr) {
-}
-
-void RefDerefVisitor::visit(CallExpr& expr) {
-    if (expr.funcValue) {
-        expr.funcValue->accept(*this);
-        expr.funcValue = simplify(expr.funcValue);
-    }
-
-    for (auto it = expr.params.begin(); it != expr.params.end(); ++it) {
-        (*it)->accept(*this);
-        *it = simplify(*it);
-    }
-}
-
-void RefDerefVisitor::visit(PointerShift& expr) {
-    expr.pointer->accept(*this);
-    expr.move->accept(*this);
-
-    expr.pointer = simplify(expr.pointer);
-    expr.move = simplify(expr.move);
-}
-
-void RefDerefVisitor::visit(GepExpr& expr) {
-    for (auto& index : expr.indices) {
-        index->accept(*this);
-    }
-}
-
-void RefDerefVisitor::visit(SelectExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-    expr.comp->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-    expr.comp = simplify(expr.comp);
-}
-
-void RefDerefVisitor::visit(RefExpr& expr) {
-    expr.expr->accept(*this);
-    expr.expr = simplify(expr.expr);
-}
-
-void RefDerefVisitor::visit(DerefExpr& expr) {
-    expr.expr->accept(*this);
-    expr.expr = simplify(expr.expr);
-}
-
-void RefDerefVisitor::visit(RetExpr& expr) {
-    if (expr.expr) {
-        expr.expr->accept(*this);
-        expr.expr = simplify(expr.expr);
-    }
-}
-
-void RefDerefVisitor::visit(CastExpr& expr) {
-    expr.expr->accept(*this);
-    expr.expr = simplify(expr.expr);
-}
-
-void RefDerefVisitor::visit(AddExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(SubExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(AssignExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(MulExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(DivExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(RemExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(AndExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(OrExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(XorExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(CmpExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(AshrExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(LshrExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
-
-void RefDerefVisitor::visit(ShlExpr& expr) {
-    expr.left->accept(*this);
-    expr.right->accept(*this);
-
-    expr.left = simplify(expr.left);
-    expr.right = simplify(expr.right);
-}
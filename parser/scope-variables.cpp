@@ -0,0 +1,784 @@
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/PostOrderIterator.h>
+
+#include "../core/Program.h"
+#include "../core/Func.h"
+#include "../core/Block.h"
+
+#include "../expr/ExprVisitor.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+/*
+ * Local variables are declared at the start of the narrowest C scope which contains
+ * all their occurrences: the function body, a loop body or the braces of a block
+ * written in place. The scope must not be left and entered again while the variable
+ * holds a value, so a variable live at the start of the scope is declared outside of it.
+ * Temporaries and phi variables are live from an assignment to their last use, locals
+ * of allocas between llvm.lifetime.start and llvm.lifetime.end. Allocas without lifetime
+ * markers may be used through pointers anywhere, they stay in the function body.
+ * Locals of allocas with the same type whose lifetimes never overlap share one variable.
+ */
+
+/**
+ * @brief The VariableVisitor finds the occurrences of local variables in a statement.
+ */
+class VariableVisitor : public ExprVisitor {
+    const std::map<std::string, unsigned>& indices;
+
+    void operand(Expr* expr);
+
+public:
+    // indices of the variables, a statement has only a few of them
+    std::vector<unsigned> uses;
+    std::vector<unsigned> defs; //variables assigned as a whole, their previous value is not used
+
+    VariableVisitor(const std::map<std::string, unsigned>& indices)
+        : indices(indices) {}
+
+    /**
+     * @brief statement Collects the variables of the statement, replacing the previous ones.
+     */
+    void statement(Expr* stmt);
+
+    void visit(Value& expr) override;
+    void visit(StructElement& expr) override;
+    void visit(ArrayElement& expr) override;
+    void visit(ExtractValueExpr& expr) override;
+    void visit(IfExpr& expr) override;
+    void visit(SwitchExpr& expr) override;
+    void visit(AsmExpr& expr) override;
+    void visit(CallExpr& expr) override;
+    void visit(PointerShift& expr) override;
+    void visit(GepExpr& expr) override;
+    void visit(SelectExpr& expr) override;
+    void visit(RefExpr& expr) override;
+    void visit(DerefExpr& expr) override;
+    void visit(RetExpr& expr) override;
+    void visit(IndirectGotoExpr& expr) override;
+    void visit(CastExpr& expr) override;
+    void visit(AddExpr& expr) override;
+    void visit(SubExpr& expr) override;
+    void visit(AssignExpr& expr) override;
+    void visit(MulExpr& expr) override;
+    void visit(DivExpr& expr) override;
+    void visit(RemExpr& expr) override;
+    void visit(AndExpr& expr) override;
+    void visit(OrExpr& expr) override;
+    void visit(XorExpr& expr) override;
+    void visit(CmpExpr& expr) override;
+    void visit(AshrExpr& expr) override;
+    void visit(LshrExpr& expr) override;
+    void visit(ShlExpr& expr) override;
+    void visit(InsertElementExpr& expr) override;
+    void visit(ShuffleVectorExpr& expr) override;
+    void visit(ConvertVectorExpr& expr) override;
+    void visit(AtomicRMWExpr& expr) override;
+    void visit(VectorReduceExpr& expr) override;
+    void visit(StackAlloc& expr) override;
+};
+
+/**
+ * @brief The Variable struct describes a local variable whose declaration may be moved.
+ */
+struct Variable {
+    Value* value;
+    StackAlloc* decl; //nullptr for phi variables, which are declared here
+    Block* declBlock; //block of the original declaration
+    const llvm::AllocaInst* alloca; //nullptr for temporaries and phi variables
+    bool lifetime = false; //alloca with lifetime markers
+    unsigned slot; //variable sharing the declaration, the variable itself if none
+};
+
+class VariableScopes {
+private:
+    Func* func;
+    const llvm::Function& function;
+
+    std::vector<Variable> variables;
+    std::map<std::string, unsigned> indices;
+
+    // written blocks in the order in which they are written
+    std::vector<Block*> blocks;
+    llvm::DenseMap<const Block*, unsigned> blockIndices;
+
+    // block -> block opening the scope in which its statements are written
+    llvm::DenseMap<const Block*, Block*> contentScope;
+    // block opening a scope -> block opening the enclosing scope, nullptr for the function body
+    llvm::DenseMap<const Block*, Block*> scopeParent;
+
+    // per written block
+    std::vector<llvm::BitVector> occurrences;
+    std::vector<llvm::BitVector> liveIn; //of temporaries and phi variables
+    std::vector<llvm::BitVector> lifetimeLive; //allocas live at some point of the block
+    std::vector<llvm::BitVector> lifetimeLiveIn;
+
+    // per variable, nullptr if it does not occur in any written block
+    std::vector<Block*> occurrenceScopes;
+
+    // allocas live at the same time, empty for other variables
+    std::vector<llvm::BitVector> interference;
+
+    void walk(Block* block, Block* scope) {
+        blockIndices[block] = blocks.size();
+        blocks.push_back(block);
+
+        auto* content = block->isLoopHeader ? block : scope;
+        contentScope[block] = content;
+        if (block->isLoopHeader) {
+            scopeParent[block] = scope;
+        }
+
+        for (auto* inlined : inlinedBlocks(block)) {
+            scopeParent[inlined] = content;
+            walk(inlined, inlined);
+        }
+
+        for (auto* follower : block->followers) {
+            walk(follower, content);
+        }
+
+        for (auto* exit : block->loopExits) {
+            walk(exit, scope);
+        }
+    }
+
+    static std::vector<Block*> inlinedBlocks(const Block* block) {
+        std::vector<Block*> inlined;
+        if (block->expressions.empty()) {
+            return inlined;
+        }
+
+        if (auto* ifExpr = dynamic_cast<IfExpr*>(block->expressions.back())) {
+            if (ifExpr->trueJump == JumpKind::INLINE) {
+                inlined.push_back(ifExpr->trueBlock);
+            }
+            if (ifExpr->cmp && ifExpr->falseJump == JumpKind::INLINE) {
+                inlined.push_back(ifExpr->falseBlock);
+            }
+        } else if (auto* switchExpr = dynamic_cast<SwitchExpr*>(block->expressions.back())) {
+            for (auto* target : switchExpr->targets()) {
+                auto it = switchExpr->jumps.find(target);
+                if (it != switchExpr->jumps.end() && it->second == JumpKind::INLINE) {
+                    inlined.push_back(target);
+                }
+            }
+        }
+
+        return inlined;
+    }
+
+    // successors of the block with the phi copies done on the way
+    std::vector<std::pair<const Block*, const std::vector<Expr*>*>> successors(const Block* block) const {
+        static const std::vector<Expr*> noCopies;
+        std::vector<std::pair<const Block*, const std::vector<Expr*>*>> result;
+
+        auto* terminator = block->expressions.empty() ? nullptr : block->expressions.back();
+        if (auto* ifExpr = dynamic_cast<IfExpr*>(terminator)) {
+            result.push_back({ifExpr->trueBlock, &ifExpr->trueCopies});
+            if (ifExpr->cmp) {
+                result.push_back({ifExpr->falseBlock, &ifExpr->falseCopies});
+            }
+        } else if (auto* switchExpr = dynamic_cast<SwitchExpr*>(terminator)) {
+            for (auto* target : switchExpr->targets()) {
+                auto it = switchExpr->copies.find(target);
+                result.push_back({target, it != switchExpr->copies.end() ? &it->second : &noCopies});
+            }
+        } else {
+            for (const auto* succ : llvm::successors(block->block)) {
+                result.push_back({func->getBlock(succ), &noCopies});
+            }
+        }
+
+        return result;
+    }
+
+    void addVariable(Value* value, StackAlloc* decl, Block* declBlock) {
+        auto it = indices.find(value->valueName);
+        if (it != indices.end()) {
+            return;
+        }
+
+        indices[value->valueName] = variables.size();
+        variables.push_back(Variable{value, decl, declBlock, nullptr, false, static_cast<unsigned>(variables.size())});
+    }
+
+    void findVariables() {
+        for (auto* block : blocks) {
+            for (auto* expr : block->expressions) {
+                auto* decl = dynamic_cast<StackAlloc*>(expr);
+                // variable-length arrays are allocated where they are declared
+                if (decl && !decl->count) {
+                    addVariable(decl->value, decl, block);
+                }
+            }
+        }
+
+        for (auto* var : func->phiVariables) {
+            addVariable(var, nullptr, func->entryBlock);
+        }
+
+        for (const auto& entry : func->blockMap) {
+            for (const auto& value : entry.second->getTables().valueMap) {
+                auto it = indices.find(value.second->valueName);
+                if (it != indices.end()) {
+                    variables[it->second].alloca = llvm::dyn_cast<llvm::AllocaInst>(value.first);
+                }
+            }
+        }
+    }
+
+    // forward dataflow of llvm.lifetime.start and llvm.lifetime.end
+    void findLifetimes() {
+        unsigned count = variables.size();
+        llvm::DenseMap<const llvm::AllocaInst*, unsigned> allocaIndices;
+        for (unsigned i = 0; i < count; ++i) {
+            if (variables[i].alloca) {
+                allocaIndices[variables[i].alloca] = i;
+            }
+        }
+
+        interference.assign(count, llvm::BitVector());
+        for (unsigned i = 0; i < count; ++i) {
+            if (variables[i].alloca) {
+                interference[i].resize(count);
+            }
+        }
+        lifetimeLive.assign(blocks.size(), llvm::BitVector(count));
+        lifetimeLiveIn.assign(blocks.size(), llvm::BitVector(count));
+
+        // marker -> variable, and whether it starts the lifetime
+        llvm::DenseMap<const llvm::Instruction*, std::pair<unsigned, bool>> markers;
+        for (const auto& block : function) {
+            for (const auto& ins : block) {
+                auto* intrinsic = llvm::dyn_cast<llvm::IntrinsicInst>(&ins);
+                if (!intrinsic || (intrinsic->getIntrinsicID() != llvm::Intrinsic::lifetime_start && intrinsic->getIntrinsicID() != llvm::Intrinsic::lifetime_end)) {
+                    continue;
+                }
+
+                auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(intrinsic->getArgOperand(1)->stripPointerCasts());
+                auto it = alloca ? allocaIndices.find(alloca) : allocaIndices.end();
+                if (it == allocaIndices.end()) {
+                    // the marker may refer to any alloca, none of them can be trusted
+                    for (auto& var : variables) {
+                        var.lifetime = false;
+                    }
+                    return;
+                }
+
+                markers[&ins] = {it->second, intrinsic->getIntrinsicID() == llvm::Intrinsic::lifetime_start};
+                variables[it->second].lifetime = true;
+            }
+        }
+
+        auto transfer = [&](const llvm::BasicBlock* block, llvm::BitVector live, bool record) {
+            for (const auto& ins : *block) {
+                auto it = markers.find(&ins);
+                if (it == markers.end()) {
+                    continue;
+                }
+
+                unsigned var = it->second.first;
+                if (it->second.second) {
+                    if (record) {
+                        interference[var] |= live;
+                        lifetimeLive[blockIndices[func->getBlock(block)]].set(var);
+                    }
+                    live.set(var);
+                } else {
+                    live.reset(var);
+                }
+            }
+            return live;
+        };
+
+        // allocas without markers are live everywhere
+        llvm::BitVector always(count);
+        for (unsigned i = 0; i < count; ++i) {
+            if (variables[i].alloca && !variables[i].lifetime) {
+                always.set(i);
+            }
+        }
+
+        llvm::ReversePostOrderTraversal<const llvm::Function*> rpo(&function);
+        llvm::DenseMap<const llvm::BasicBlock*, llvm::BitVector> liveOut;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (const auto* block : rpo) {
+                llvm::BitVector live = always;
+                for (const auto* pred : llvm::predecessors(block)) {
+                    auto it = liveOut.find(pred);
+                    if (it != liveOut.end()) {
+                        live |= it->second;
+                    }
+                }
+
+                auto out = transfer(block, live, false);
+                auto& old = liveOut[block];
+                if (old.size() != out.size() || old != out) {
+                    old = out;
+                    changed = true;
+                }
+            }
+        }
+
+        for (const auto* block : rpo) {
+            auto it = blockIndices.find(func->getBlock(block));
+            if (it == blockIndices.end()) {
+                continue;
+            }
+
+            llvm::BitVector live = always;
+            for (const auto* pred : llvm::predecessors(block)) {
+                auto out = liveOut.find(pred);
+                if (out != liveOut.end()) {
+                    live |= out->second;
+                }
+            }
+
+            lifetimeLiveIn[it->second] = live;
+            lifetimeLive[it->second] |= live;
+            for (int var = live.find_first(); var != -1; var = live.find_next(var)) {
+                interference[var] |= live;
+            }
+            transfer(block, live, true);
+        }
+    }
+
+    // allocas of the same type whose lifetimes do not overlap get the same variable
+    void shareSlots() {
+        std::map<std::string, std::vector<unsigned>> slots;
+
+        for (unsigned i = 0; i < variables.size(); ++i) {
+            auto& var = variables[i];
+            if (!var.lifetime) {
+                continue;
+            }
+
+            auto* type = var.decl->getType();
+            std::string key = type->toString() + type->surroundName("") + "/" + std::to_string(var.decl->alignment);
+
+            for (unsigned slot : slots[key]) {
+                if (!interference[slot].test(i)) {
+                    var.slot = slot;
+                    var.value->valueName = variables[slot].value->valueName;
+                    interference[slot] |= interference[i];
+                    for (int other = interference[i].find_first(); other != -1; other = interference[i].find_next(other)) {
+                        interference[other].set(slot);
+                    }
+                    for (auto& live : lifetimeLive) {
+                        if (live.test(i)) {
+                            live.set(slot);
+                        }
+                    }
+                    for (auto& live : lifetimeLiveIn) {
+                        if (live.test(i)) {
+                            live.set(slot);
+                        }
+                    }
+                    break;
+                }
+            }
+
+            if (var.slot == i) {
+                slots[key].push_back(i);
+            }
+        }
+    }
+
+    // backward dataflow of temporaries and phi variables over the written statements
+    void findOccurrences() {
+        unsigned count = variables.size();
+        VariableVisitor visitor(indices);
+
+        occurrences.assign(blocks.size(), llvm::BitVector(count));
+        std::vector<llvm::BitVector> gen(blocks.size(), llvm::BitVector(count));
+        std::vector<llvm::BitVector> kill(blocks.size(), llvm::BitVector(count));
+
+        auto sequence = [&](const std::vector<Expr*>& exprs, llvm::BitVector& gen, llvm::BitVector& kill, llvm::BitVector& seen) {
+            for (auto* expr : exprs) {
+                visitor.statement(expr);
+                for (unsigned var : visitor.uses) {
+                    if (!kill.test(var)) {
+                        gen.set(var);
+                    }
+                    seen.set(var);
+                }
+                for (unsigned var : visitor.defs) {
+                    kill.set(var);
+                    seen.set(var);
+                }
+            }
+        };
+
+        // per edge: uses and assignments of the phi copies
+        std::vector<std::vector<std::pair<unsigned, std::pair<llvm::BitVector, llvm::BitVector>>>> edges(blocks.size());
+
+        for (unsigned b = 0; b < blocks.size(); ++b) {
+            sequence(blocks[b]->expressions, gen[b], kill[b], occurrences[b]);
+
+            for (const auto& succ : successors(blocks[b])) {
+                auto it = blockIndices.find(succ.first);
+                if (it == blockIndices.end()) {
+                    continue;
+                }
+
+                llvm::BitVector edgeGen(count), edgeKill(count);
+                sequence(*succ.second, edgeGen, edgeKill, occurrences[b]);
+                edges[b].push_back({it->second, {edgeGen, edgeKill}});
+            }
+        }
+
+        // the value of an alloca is kept by its lifetime, not by its assignments
+        llvm::BitVector registers(count);
+        for (unsigned i = 0; i < count; ++i) {
+            if (!variables[i].alloca) {
+                registers.set(i);
+            }
+        }
+
+        liveIn.assign(blocks.size(), llvm::BitVector(count));
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (unsigned b = blocks.size(); b-- > 0;) {
+                llvm::BitVector live(count);
+                for (const auto& edge : edges[b]) {
+                    llvm::BitVector out = liveIn[edge.first];
+                    out.reset(edge.second.second);
+                    out |= edge.second.first;
+                    live |= out;
+                }
+
+                live.reset(kill[b]);
+                live |= gen[b];
+                live &= registers;
+
+                if (live != liveIn[b]) {
+                    liveIn[b] = live;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    Block* commonScope(Block* first, Block* second) const {
+        std::vector<Block*> path;
+        for (auto* scope = first; scope; scope = scopeParent.lookup(scope)) {
+            path.push_back(scope);
+        }
+
+        for (auto* scope = second; scope; scope = scopeParent.lookup(scope)) {
+            if (std::find(path.begin(), path.end(), scope) != path.end()) {
+                return scope;
+            }
+        }
+
+        return func->entryBlock;
+    }
+
+    bool isLiveIn(unsigned var, const Block* scope) const {
+        unsigned b = blockIndices.lookup(scope);
+        return variables[var].alloca ? lifetimeLiveIn[b].test(var) : liveIn[b].test(var);
+    }
+
+    // narrowest scope of all blocks in which the variable occurs or its lifetime is live
+    void findOccurrenceScopes() {
+        occurrenceScopes.assign(variables.size(), nullptr);
+
+        for (unsigned b = 0; b < blocks.size(); ++b) {
+            // variables sharing the declaration occur under its name
+            llvm::BitVector occurring = occurrences[b];
+            occurring |= lifetimeLive[b];
+
+            auto* content = contentScope.lookup(blocks[b]);
+            for (int var = occurring.find_first(); var != -1; var = occurring.find_next(var)) {
+                auto& scope = occurrenceScopes[var];
+                scope = scope ? commonScope(scope, content) : content;
+            }
+        }
+    }
+
+    Block* findScope(unsigned var) const {
+        const auto& variable = variables[var];
+        if (variable.alloca && !variable.lifetime) {
+            return func->entryBlock;
+        }
+
+        Block* scope = occurrenceScopes[var];
+        if (!scope) {
+            scope = contentScope.lookup(variable.declBlock);
+        }
+
+        // a loop header deciding only whether to leave the loop is written as while (cond)
+        while (scope != func->entryBlock && (isLiveIn(var, scope) || (scope->isLoopHeader && scope->expressions.size() <= 1))) {
+            scope = scopeParent.lookup(scope);
+        }
+
+        return scope;
+    }
+
+public:
+    VariableScopes(Func* func, const llvm::Function& function)
+        : func(func), function(function) { }
+
+    void run() {
+        walk(func->entryBlock, func->entryBlock);
+        scopeParent[func->entryBlock] = nullptr;
+
+        findVariables();
+        findLifetimes();
+        shareSlots();
+        findOccurrences();
+        findOccurrenceScopes();
+
+        for (auto* block : blocks) {
+            auto& exprs = block->expressions;
+            exprs.erase(std::remove_if(exprs.begin(), exprs.end(), [this](Expr* expr) {
+                auto* decl = dynamic_cast<StackAlloc*>(expr);
+                return decl && indices.count(decl->value->valueName);
+            }), exprs.end());
+        }
+
+        std::map<Block*, std::vector<Expr*>> declarations;
+        std::vector<Block*> scopes(variables.size());
+        for (unsigned i = 0; i < variables.size(); ++i) {
+            if (variables[i].slot == i) {
+                scopes[i] = findScope(i);
+            }
+        }
+
+        for (unsigned i = 0; i < variables.size(); ++i) {
+            auto& var = variables[i];
+            if (var.slot != i) {
+                continue;
+            }
+
+            Expr* decl = var.decl;
+            if (!decl) {
+                decl = scopes[i]->own(std::make_unique<StackAlloc>(var.value));
+            }
+            declarations[scopes[i]].push_back(decl);
+        }
+
+        for (auto& entry : declarations) {
+            auto& exprs = entry.first->expressions;
+            exprs.insert(exprs.begin(), entry.second.begin(), entry.second.end());
+        }
+    }
+};
+
+void scopeVariables(const llvm::Module* module, Program& program) {
+    for (const llvm::Function& function : module->functions()) {
+        auto* func = program.getFunction(&function);
+        if (!func || function.isDeclaration()) {
+            continue;
+        }
+
+        VariableScopes scopes(func, function);
+        scopes.run();
+    }
+}
+
+void VariableVisitor::statement(Expr* stmt) {
+    uses.clear();
+    defs.clear();
+    stmt->accept(*this);
+}
+
+void VariableVisitor::operand(Expr* expr) {
+    if (expr) {
+        expr->accept(*this);
+    }
+}
+
+void VariableVisitor::visit(Value& expr) {
+    auto it = indices.find(expr.valueName);
+    if (it != indices.end()) {
+        uses.push_back(it->second);
+    }
+}
+
+void VariableVisitor::visit(StructElement& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(ArrayElement& expr) {
+    operand(expr.expr);
+    operand(expr.element);
+}
+
+void VariableVisitor::visit(ExtractValueExpr& expr) {
+    operand(expr.indices.back().get());
+}
+
+void VariableVisitor::visit(IfExpr& expr) {
+    // phi copies are done on the edges, they are visited separately
+    operand(expr.cmp);
+}
+
+void VariableVisitor::visit(SwitchExpr& expr) {
+    operand(expr.cmp);
+}
+
+void VariableVisitor::visit(AsmExpr& expr) {
+    // outputs may be written only partially, they count as uses
+    for (auto& out : expr.output) {
+        operand(out.second);
+    }
+
+    for (auto& in : expr.input) {
+        operand(in.second);
+    }
+}
+
+void VariableVisitor::visit(CallExpr& expr) {
+    operand(expr.funcValue);
+
+    for (auto param : expr.params) {
+        operand(param);
+    }
+}
+
+void VariableVisitor::visit(PointerShift& expr) {
+    operand(expr.pointer);
+    operand(expr.move);
+}
+
+void VariableVisitor::visit(GepExpr& expr) {
+    operand(expr.indices.back().get());
+}
+
+void VariableVisitor::visit(SelectExpr& expr) {
+    operand(expr.comp);
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(RefExpr& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(DerefExpr& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(RetExpr& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(IndirectGotoExpr& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(CastExpr& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(AddExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(SubExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(AssignExpr& expr) {
+    operand(expr.right);
+
+    // the assigned variable is used only if the right side uses it
+    auto* var = dynamic_cast<Value*>(expr.left);
+    auto it = var ? indices.find(var->valueName) : indices.end();
+    if (it != indices.end()) {
+        defs.push_back(it->second);
+    } else {
+        operand(expr.left);
+    }
+}
+
+void VariableVisitor::visit(MulExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(DivExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(RemExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(AndExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(OrExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(XorExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(CmpExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(AshrExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(LshrExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(ShlExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(InsertElementExpr& expr) {
+    operand(expr.vector);
+    operand(expr.element);
+    operand(expr.index);
+}
+
+void VariableVisitor::visit(ShuffleVectorExpr& expr) {
+    operand(expr.left);
+    operand(expr.right);
+}
+
+void VariableVisitor::visit(ConvertVectorExpr& expr) {
+    operand(expr.expr);
+}
+
+void VariableVisitor::visit(AtomicRMWExpr& expr) {
+    operand(expr.pointer);
+    operand(expr.value);
+}
+
+void VariableVisitor::visit(VectorReduceExpr& expr) {
+    operand(expr.vector);
+    operand(expr.start);
+}
+
+void VariableVisitor::visit(StackAlloc& expr) {
+    // the declaration itself is not an occurrence, the size of an array is
+    operand(expr.count);
+}
@@ -0,0 +1,298 @@
+#include "../core/Program.h"
+#include "../core/Func.h"
+#include "../core/Block.h"
+
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/ADT/PostOrderIterator.h>
+
+#include <algorithm>
+#include <string>
+
+/*
+ * Recovers structured control flow. Every reachable block is written exactly once:
+ * in place of its only incoming branch, after the loop it exits, or after its
+ * immediate dominator (merge points). Loop headers open a loop that spans
+ * everything written from them. Branches then become fallthroughs, break and
+ * continue where the written order allows it and goto otherwise, which is
+ * always the case for irreducible control flow. Blocks whose address is taken
+ * are reached by computed goto, so they always keep their label.
+ */
+// hint of !llvm.loop metadata, e.g. !{!"llvm.loop.unroll.count", i32 4}
+static bool getLoopHint(const llvm::MDNode* loopID, const std::string& name, unsigned& value) {
+    for (unsigned i = 1; i < loopID->getNumOperands(); i++) {
+        auto hint = llvm::dyn_cast<llvm::MDNode>(loopID->getOperand(i));
+        if (!hint || hint->getNumOperands() == 0) {
+            continue;
+        }
+
+        auto hintName = llvm::dyn_cast<llvm::MDString>(hint->getOperand(0));
+        if (!hintName || hintName->getString() != name) {
+            continue;
+        }
+
+        value = 1;
+        if (hint->getNumOperands() > 1) {
+            if (auto constant = llvm::mdconst::dyn_extract<llvm::ConstantInt>(hint->getOperand(1))) {
+                value = constant->getZExtValue();
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// GCC pragmas where GCC has a counterpart, clang ones are guarded as GCC warns about them
+static std::vector<std::string> getLoopPragmas(const llvm::Loop* loop) {
+    std::vector<std::string> pragmas;
+
+    if (loop->isAnnotatedParallel()) {
+        pragmas.push_back("#pragma GCC ivdep");
+    }
+
+    const llvm::MDNode* loopID = loop->getLoopID();
+    if (!loopID) {
+        return pragmas;
+    }
+
+    unsigned value;
+    if (getLoopHint(loopID, "llvm.loop.unroll.disable", value)) {
+        pragmas.push_back("#pragma GCC unroll 1");
+    } else if (getLoopHint(loopID, "llvm.loop.unroll.full", value)) {
+        pragmas.push_back("#pragma GCC unroll 65534");
+    } else if (getLoopHint(loopID, "llvm.loop.unroll.count", value)) {
+        pragmas.push_back("#pragma GCC unroll " + std::to_string(value));
+    }
+
+    std::vector<std::string> clangHints;
+    if (getLoopHint(loopID, "llvm.loop.vectorize.width", value)) {
+        clangHints.push_back(value > 1 ? "vectorize_width(" + std::to_string(value) + ")" : "vectorize(disable)");
+    } else if (getLoopHint(loopID, "llvm.loop.vectorize.enable", value)) {
+        clangHints.push_back(value ? "vectorize(enable)" : "vectorize(disable)");
+    }
+
+    if (getLoopHint(loopID, "llvm.loop.interleave.count", value)) {
+        clangHints.push_back("interleave_count(" + std::to_string(value) + ")");
+    }
+
+    if (!clangHints.empty()) {
+        std::string pragma = "#ifdef __clang__\n#pragma clang loop";
+        for (const auto& hint : clangHints) {
+            pragma += " " + hint;
+        }
+        pragmas.push_back(pragma + "\n#endif");
+    }
+
+    return pragmas;
+}
+
+class Structurer {
+private:
+    // loop or switch surrounding the currently walked block
+    struct Frame {
+        const Block* header; // nullptr for switch
+        const Block* breakTarget;
+    };
+
+    Func* func;
+    llvm::DominatorTree domTree;
+    llvm::LoopInfo loops;
+
+    // block written in place -> block whose terminator writes it
+    llvm::DenseMap<const Block*, const Block*> inlinedAt;
+    std::vector<Frame> frames;
+
+    Block* getBlock(const llvm::BasicBlock* block) const {
+        return func->getBlock(block);
+    }
+
+    llvm::Loop* outermostExitedLoop(const llvm::BasicBlock* block, const llvm::BasicBlock* idom) const {
+        llvm::Loop* exited = nullptr;
+        for (auto* loop = loops.getLoopFor(idom); loop && !loop->contains(block); loop = loop->getParentLoop()) {
+            exited = loop;
+        }
+        return exited;
+    }
+
+    bool isCaseFallthrough(const llvm::BasicBlock* block, const llvm::BasicBlock* idom) const {
+        auto* mySwitch = getBlock(idom);
+        if (!llvm::isa<llvm::SwitchInst>(idom->getTerminator()) || mySwitch->expressions.empty()) {
+            return false;
+        }
+
+        const auto* switchExpr = dynamic_cast<const SwitchExpr*>(mySwitch->expressions.back());
+        if (!switchExpr) {
+            return false;
+        }
+
+        // phi copies of the switch edge would be run by the previous case too
+        const auto copies = switchExpr->copies.find(getBlock(block));
+        if (copies != switchExpr->copies.end() && !copies->second.empty()) {
+            return false;
+        }
+
+        // the previous case has to be written in the switch and all other predecessors inside of it
+        const auto targets = switchExpr->targets();
+        const auto it = std::find(targets.begin(), targets.end(), getBlock(block));
+        if (it == targets.begin() || it == targets.end() || inlinedAt.lookup(*(it - 1)) != mySwitch) {
+            return false;
+        }
+
+        const auto* previous = (*(it - 1))->block;
+        for (const auto* pred : llvm::predecessors(block)) {
+            if (pred != idom && !domTree.dominates(previous, pred)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isInlinable(const llvm::BasicBlock* block, const llvm::BasicBlock* idom) const {
+        const auto* pred = block->getSinglePredecessor();
+        if (!pred) {
+            return isCaseFallthrough(block, idom);
+        }
+
+        if (const auto* br = llvm::dyn_cast<llvm::BranchInst>(pred->getTerminator())) {
+            return br->isUnconditional() || br->getSuccessor(0) != br->getSuccessor(1);
+        }
+        return llvm::isa<llvm::SwitchInst>(pred->getTerminator());
+    }
+
+    void placeBlocks(llvm::Function& function) {
+        llvm::ReversePostOrderTraversal<llvm::Function*> rpo(&function);
+
+        for (auto* block : rpo) {
+            auto* myBlock = getBlock(block);
+            myBlock->isLoopHeader = loops.isLoopHeader(block);
+            if (block->hasAddressTaken()) {
+                myBlock->hasLabel = true;
+            }
+            if (myBlock->isLoopHeader) {
+                auto pragmas = getLoopPragmas(loops.getLoopFor(block));
+                if (!pragmas.empty()) {
+                    myBlock->createTables().loopPragmas = std::move(pragmas);
+                }
+            }
+
+            const auto* idomNode = domTree.getNode(block)->getIDom();
+            if (!idomNode) {
+                continue;
+            }
+
+            auto* idom = idomNode->getBlock();
+            if (auto* exited = outermostExitedLoop(block, idom)) {
+                getBlock(exited->getHeader())->loopExits.push_back(myBlock);
+            } else if (!myBlock->isLoopHeader && isInlinable(block, idom)) {
+                inlinedAt[myBlock] = getBlock(idom);
+            } else {
+                getBlock(idom)->followers.push_back(myBlock);
+            }
+        }
+    }
+
+    JumpKind jump(const Block* from, Block* to, const Block* follow) {
+        if (inlinedAt.lookup(to) == from) {
+            walk(to, follow);
+            return JumpKind::INLINE;
+        }
+
+        if (to == follow) {
+            return JumpKind::NONE;
+        }
+
+        if (!frames.empty() && frames.back().breakTarget == to) {
+            return JumpKind::BREAK;
+        }
+
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (it->header) {
+                if (it->header == to) {
+                    return JumpKind::CONTINUE;
+                }
+                break;
+            }
+        }
+
+        to->hasLabel = true;
+        return JumpKind::GOTO;
+    }
+
+    // @follow is the block that gets control when the written block falls off its end
+    void walkTerminator(const Block* block, const Block* follow) {
+        if (block->expressions.empty()) {
+            return;
+        }
+
+        if (auto* ifExpr = dynamic_cast<IfExpr*>(block->expressions.back())) {
+            ifExpr->trueJump = jump(block, ifExpr->trueBlock, follow);
+            if (ifExpr->cmp) {
+                ifExpr->falseJump = jump(block, ifExpr->falseBlock, follow);
+            }
+        } else if (auto* switchExpr = dynamic_cast<SwitchExpr*>(block->expressions.back())) {
+            frames.push_back(Frame{nullptr, follow});
+
+            // a case falls through only to the next case written in the switch
+            const auto targets = switchExpr->targets();
+            for (size_t i = 0; i < targets.size(); ++i) {
+                const Block* next = nullptr;
+                if (i + 1 < targets.size() && inlinedAt.lookup(targets[i + 1]) == block) {
+                    next = targets[i + 1];
+                }
+                switchExpr->jumps[targets[i]] = jump(block, targets[i], next);
+            }
+
+            frames.pop_back();
+        }
+    }
+
+    void walkSequence(const std::vector<Block*>& blocks, const Block* follow) {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            walk(blocks[i], i + 1 < blocks.size() ? blocks[i + 1] : follow);
+        }
+    }
+
+    void walkContent(const Block* block, const Block* follow) {
+        walkTerminator(block, block->followers.empty() ? follow : block->followers.front());
+        walkSequence(block->followers, follow);
+    }
+
+    void walk(const Block* block, const Block* follow) {
+        if (!block->isLoopHeader) {
+            walkContent(block, follow);
+            return;
+        }
+
+        frames.push_back(Frame{block, block->loopExits.empty() ? follow : block->loopExits.front()});
+        walkContent(block, block);
+        frames.pop_back();
+
+        walkSequence(block->loopExits, follow);
+    }
+
+public:
+    Structurer(Func* func, llvm::Function& function)
+        : func(func), domTree(function), loops(domTree) { }
+
+    void run(llvm::Function& function) {
+        func->entryBlock = getBlock(&function.getEntryBlock());
+        placeBlocks(function);
+        walk(func->entryBlock, nullptr);
+    }
+};
+
+void structureBlocks(const llvm::Module* module, Program& program) {
+    for (const llvm::Function& function : module->functions()) {
+        auto* func = program.getFunction(&function);
+        if (!func || function.isDeclaration()) {
+            continue;
+        }
+
+        // the analyses only read the function, but they are not const-correct
+        auto& mutableFunction = const_cast<llvm::Function&>(function);
+        Structurer structurer(func, mutableFunction);
+        structurer.run(mutableFunction);
+    }
+}
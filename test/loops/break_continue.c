@@ -0,0 +1,47 @@
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	int sum = 0;
+
+	for (int i = 0; i < 20; i++) {
+		if (i % 3 == 0) {
+			continue;
+		}
+
+		for (int j = 0; j < i; j++) {
+			if (j == 4) {
+				break;
+			}
+
+			switch ((num + i + j) & 3) {
+			case 0:
+				sum += 2;
+			case 1:
+				sum += i;
+				break;
+			case 2:
+				continue;
+			default:
+				sum -= j;
+			}
+		}
+
+		if (sum > 200) {
+			goto done;
+		}
+	}
+
+done:
+	return sum & 0x7f;
+}
@@ -0,0 +1,21 @@
+#include <stdlib.h>
+
+int main(int argc, char *argv[])
+{
+    char *p;
+    int v = strtol(argv[1], &p, 10);
+    int a = 1, b = 2, c = 3;
+    int x = v, y = 7;
+    for (int i = 0; i < v + 10; i++) {
+        int t = a;
+        a = b;
+        b = c;
+        c = t;
+        if (i % 3 == 0) {
+            int s = x;
+            x = y;
+            y = s;
+        }
+    }
+    return (a * 100 + b * 10 + c + x - y) & 0xff;
+}
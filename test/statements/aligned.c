@@ -0,0 +1,36 @@
+#include <stdlib.h>
+
+static float a[64] __attribute__((aligned(32)));
+static float b[64] __attribute__((aligned(32)));
+
+__attribute__((noinline)) static void scale(float* restrict x, const float* restrict y, int n) {
+	x = __builtin_assume_aligned(x, 32);
+	y = __builtin_assume_aligned(y, 32);
+	for (int i = 0; i < n; i++) {
+		x[i] += 2 * y[i];
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	for (int i = 0; i < 64; i++) {
+		a[i] = i;
+		b[i] = num;
+	}
+
+	scale(a, b, 64);
+
+	int result = (int)a[num & 63];
+
+	return result & 0x7f;
+}
@@ -0,0 +1,35 @@
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	int counter = 0;
+	long wide = num;
+	float f = 1.5f;
+
+	for (int i = 0; i < num + 12; i++) {
+		__atomic_fetch_add(&counter, 3, __ATOMIC_SEQ_CST);
+		__atomic_fetch_xor(&wide, i, __ATOMIC_RELAXED);
+	}
+
+	int expected = counter;
+	int swapped = __atomic_compare_exchange_n(&counter, &expected, expected - num, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	int failed = __atomic_compare_exchange_n(&counter, &expected, 0, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&counter, __atomic_load_n(&counter, __ATOMIC_ACQUIRE) + expected, __ATOMIC_RELEASE);
+
+	float old = __atomic_exchange_n(&counter, 5, __ATOMIC_SEQ_CST);
+	__atomic_store(&f, &old, __ATOMIC_SEQ_CST);
+
+	return (counter + (int)wide + swapped * 2 + failed * 4 + (int)f) & 0x7f;
+}
@@ -0,0 +1,37 @@
+#include <stdlib.h>
+
+__attribute__((noinline)) static long square(long x) {
+	return x * x;
+}
+
+__attribute__((cold, noinline)) static int fail(void) {
+	return 100;
+}
+
+__attribute__((pure)) static long sum(const long* restrict a, const long* restrict b, int n) {
+	long s = 0;
+	for (int i = 0; i < n; i++) {
+		s += a[i] * b[i];
+	}
+	return s;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return fail();
+	}
+
+	long a[4] = {num, num + 1, num + 2, num + 3};
+	long b[4] = {1, 2, 3, 4};
+
+	long result = sum(a, b, 4) + square(num);
+
+	return result & 0x7f;
+}
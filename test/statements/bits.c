@@ -0,0 +1,39 @@
+#include <stdlib.h>
+
+static unsigned rotl(unsigned x, unsigned n) {
+	return (x << (n & 31)) | (x >> (-n & 31));
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	unsigned x = (unsigned)num * 2654435761u;
+	unsigned long y = (unsigned long)num << 40 | 0xff;
+	int sum;
+	int overflow = __builtin_add_overflow((int)num * 30000000, 2100000000, &sum);
+	unsigned long product;
+	overflow += __builtin_umull_overflow(y, y, &product) * 2;
+
+	int result = __builtin_popcount(x) + __builtin_popcountl(y);
+	result += __builtin_clz(x | 1) + __builtin_ctzl(y);
+	result += __builtin_bswap32(x) >> 24;
+	result += rotl(x, num) & 0xf;
+	result += abs((int)num * 3) + overflow;
+
+	// negative narrow integers, sign-extended or truncated to their width
+	signed char c = (signed char)(num * 37 - 1);
+	short s = (short)(num * -3001 - 1);
+	result += __builtin_popcount(c) + __builtin_popcount((unsigned char)c) + __builtin_popcount((unsigned short)s);
+	result += __builtin_clz(s) + __builtin_clz((unsigned char)(c | 1)) + __builtin_clz((unsigned short)s | 1);
+
+	return result & 0x7f;
+}
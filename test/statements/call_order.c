@@ -0,0 +1,30 @@
+#include <stdlib.h>
+
+int counter;
+
+int next(int step) {
+	counter += step;
+	return counter;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	counter = num;
+
+	int before = counter;
+	int first = next(2);
+	int second = next(3);
+	int after = counter;
+
+	return (before * 3 + first * 5 - second + after) & 0x7f;
+}
@@ -0,0 +1,41 @@
+#include <stdlib.h>
+
+int run(const int* code, int acc) {
+	static void* table[] = {&&inc, &&dbl, &&halt};
+
+	goto *table[*code];
+
+inc:
+	acc++;
+	goto *table[*++code];
+
+dbl:
+	acc *= 2;
+	goto *table[*++code];
+
+halt:
+	return acc;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	int code[] = {0, 1, 0, 1, 1, 2};
+	void* target = num > 0 ? &&positive : &&negative;
+	goto *target;
+
+positive:
+	return run(code, num) & 0x7f;
+
+negative:
+	return run(code + 1, -num) & 0x7f;
+}
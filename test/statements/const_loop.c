@@ -0,0 +1,36 @@
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// never returns, a call with unused result must not be removed as a call of a const function
+__attribute__((const, noinline)) static int spin(int x) {
+	while (1) {
+		x++;
+	}
+	return x;
+}
+
+static void timeout(int sig) {
+	_exit(42);
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	if (num == 0) {
+		signal(SIGALRM, timeout);
+		ualarm(10000, 0);
+		spin(num);
+	}
+
+	return num & 0x7f;
+}
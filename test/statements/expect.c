@@ -0,0 +1,37 @@
+#include <stdlib.h>
+
+static int classify(long num) {
+	if (__builtin_expect(num < 0, 0)) {
+		return 1;
+	}
+
+	switch (__builtin_expect(num % 4, 2)) {
+	case 0:
+		return 2;
+	case 1:
+		return 3;
+	case 2:
+		return 4;
+	case 3:
+		return 5;
+	}
+
+	__builtin_unreachable();
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	int result = classify(num) + classify(num + 1) * 8;
+
+	return result & 0x7f;
+}
@@ -0,0 +1,35 @@
+#include <stdlib.h>
+
+#pragma clang fp reassociate(on) contract(fast)
+double sum(double* a, int n) {
+	double result = 0.0;
+	for (int i = 0; i < n; i++) {
+		result += a[i] * a[i];
+	}
+	return result;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	double a[16];
+	for (int i = 0; i < 16; i++) {
+		a[i] = num - i;
+	}
+
+	int result = (int)sum(a, 16);
+	for (int i = num; i < num + 8; i++) {
+		result += i / 2;
+	}
+
+	return result & 0x7f;
+}
@@ -0,0 +1,49 @@
+#include <stdlib.h>
+
+void fill(int* a, int n, int k) {
+	for (int i = 0; i < n; i++) {
+		a[i] = k + i;
+	}
+}
+
+int total(int* a, int n) {
+	int sum = 0;
+	for (int i = 0; i < n; i++) {
+		sum += a[i];
+	}
+	return sum;
+}
+
+int sum(int n) {
+	int result = 0;
+	for (int i = 0; i < n; i++) {
+		int x;
+		{
+			int a[4];
+			fill(a, 4, i);
+			x = total(a, 4);
+		}
+		if (i % 2) {
+			int b[4];
+			fill(b, 4, x);
+			x = total(b, 4);
+		}
+		result += x;
+	}
+	return result;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	return sum(num) & 0x7f;
+}
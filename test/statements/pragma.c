@@ -0,0 +1,33 @@
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	int a[64];
+#pragma clang loop unroll(disable)
+	for (int i = 0; i < 64; i++) {
+		a[i] = num + i;
+	}
+
+	int result = 0;
+#pragma clang loop vectorize_width(4) interleave_count(2)
+	for (int i = 0; i < 64; i++) {
+		result += a[i];
+	}
+
+#pragma unroll 4
+	for (int i = 0; i < num; i++) {
+		result ^= i;
+	}
+
+	return result & 0x7f;
+}
@@ -0,0 +1,46 @@
+#include <stdlib.h>
+
+int wide(long x) {
+	switch (x) {
+	case 5000000000L:
+	case 5000000001L:
+	case 5000000002L:
+		return 1;
+	case -1:
+	case 0:
+		return 2;
+	case 1:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+int narrow(unsigned char x) {
+	switch (x) {
+	case 253:
+	case 254:
+	case 255:
+		return 5;
+	case 10:
+	case 11:
+		return 6;
+	default:
+		return 7;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	return (wide(num + 5000000000L) + wide(num - 1) * 8 + narrow(num + 253) * 64) & 0x7f;
+}
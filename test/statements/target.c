@@ -0,0 +1,39 @@
+#include <stdlib.h>
+
+__attribute__((target("avx2"), noinline)) static long sum_avx2(const int* a, int n) {
+	long s = 0;
+	for (int i = 0; i < n; i++) {
+		s += a[i];
+	}
+	return s;
+}
+
+__attribute__((noinline)) static long sum(const int* a, int n) {
+	long s = 0;
+	for (int i = 0; i < n; i++) {
+		s += a[i];
+	}
+	return s;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	int a[32];
+	for (int i = 0; i < 32; i++) {
+		a[i] = num * i;
+	}
+
+	long result = __builtin_cpu_supports("avx2") ? sum_avx2(a, 32) : sum(a, 32);
+
+	return result & 0x7f;
+}
@@ -0,0 +1,26 @@
+#include <stdlib.h>
+
+typedef int v4si __attribute__((vector_size(16)));
+typedef float v4sf __attribute__((vector_size(16)));
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	v4si a = {num, num * 2, -3, 7};
+	v4si b = {1, -num, 5, num};
+	v4si c = (a + b) * 3 / (v4si){1, 2, -2, 4};
+	v4si m = a < b;
+	v4sf f = __builtin_convertvector(c, v4sf) * 0.5f;
+	c[2] = num;
+
+	return (c[0] + c[1] + c[2] + c[3] + m[1] + (int)f[3]) & 0x7f;
+}
@@ -0,0 +1,56 @@
+#include <stdlib.h>
+
+typedef int v4si __attribute__((vector_size(16)));
+typedef unsigned v4su __attribute__((vector_size(16)));
+typedef unsigned short v8hu __attribute__((vector_size(16)));
+typedef float v4sf __attribute__((vector_size(16)));
+
+// the reduction builtins are translated to llvm.vector.reduce.* intrinsics
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_reduce_add)
+#define HAS_REDUCE
+#endif
+#endif
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	v4si a = {num, num * 3, -7, 0x7fffffff};
+	v4su u = (v4su)a;
+	v8hu h = {num, 3, 65535, 2, num * 5, 1, 1, 4};
+	v4sf f = {num, 0.5f, -2.0f, num * 0.25f};
+
+#ifdef HAS_REDUCE
+	unsigned sum = __builtin_reduce_add(u);
+	int max = __builtin_reduce_max(a);
+	unsigned min = __builtin_reduce_min(u);
+	int xor = __builtin_reduce_xor(a);
+	int hmax = __builtin_reduce_max(h);
+	int fmax = __builtin_reduce_max(f);
+#else
+	unsigned sum = 0, min = u[0];
+	int max = a[0], xor = 0, hmax = 0;
+	float fmax = f[0];
+	for (int i = 0; i < 4; i++) {
+		sum += u[i];
+		max = a[i] > max ? a[i] : max;
+		min = u[i] < min ? u[i] : min;
+		xor ^= a[i];
+		fmax = f[i] > fmax ? f[i] : fmax;
+	}
+	for (int i = 0; i < 8; i++) {
+		hmax = h[i] > hmax ? h[i] : hmax;
+	}
+#endif
+
+	return (sum + max + min + xor + hmax + (int)fmax) & 0x7f;
+}
@@ -0,0 +1,31 @@
+#include <stdlib.h>
+
+int sum(int n) {
+	int result = 0;
+	for (int i = 0; i < n; i++) {
+		int a[i + 1];
+		for (int j = 0; j <= i; j++) {
+			a[j] = i * j;
+		}
+		result += a[i] - a[0];
+	}
+	return result;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	long b[num + 2];
+	b[num + 1] = num;
+
+	return (sum(num) + b[num + 1]) & 0x7f;
+}
@@ -120,7 +120,7 @@ std::string ArrayType::sizeToString() const {
     return ret;
 }
 
-std::string ArrayType::surroundName(const std::string& name) {
+std::string ArrayType::surroundName(const std::string& name) const {
     std::string ret;
     if (isPointerArray && pointer->isArrayPointer) {
         ret = "(";
@@ -133,6 +133,46 @@ std::string ArrayType::surroundName(const std::string& name) {
     }
 }
 
+VectorType::VectorType(std::unique_ptr<Type> type, unsigned size, unsigned bytes, unsigned align, const std::string& name)
+    : type(std::move(type)),
+      size(size),
+      bytes(bytes),
+      align(align),
+      name(name) { }
+
+VectorType::VectorType(const VectorType& other) {
+    type = other.type->clone();
+    size = other.size;
+    bytes = other.bytes;
+    align = other.align;
+    name = other.name;
+    isConst = other.isConst;
+    isStatic = other.isStatic;
+}
+
+std::unique_ptr<Type> VectorType::clone() const  {
+    return std::make_unique<VectorType>(*this);
+}
+
+void VectorType::print() const {
+    llvm::outs() << toString();
+}
+
+std::string VectorType::toString() const {
+    std::string ret = getConstStaticString();
+
+    return ret + name;
+}
+
+std::string VectorType::attributesToString() const {
+    std::string ret = " __attribute__((vector_size(" + std::to_string(bytes) + ")";
+    if (align != 0) {
+        ret += ", aligned(" + std::to_string(align) + ")";
+    }
+
+    return ret + "))";
+}
+
 std::unique_ptr<Type> VoidType::clone() const  {
     return std::make_unique<VoidType>();
 }
@@ -199,7 +239,7 @@ std::string PointerType::toString() const {
     return ret + type->toString() + "*";
 }
 
-std::string PointerType::surroundName(const std::string& name) {
+std::string PointerType::surroundName(const std::string& name) const {
     std::string ret;
 
     if (isArrayPointer && name != "0") {
@@ -31,7 +31,7 @@ public:
         return ret;
     }
 
-    virtual std::string surroundName(const std::string& name) {
+    virtual std::string surroundName(const std::string& name) const {
         return name;
     }
 };
@@ -99,7 +99,7 @@ public:
     void print() const override;
     std::string toString() const override;
 
-    std::string surroundName(const std::string& name) override;
+    std::string surroundName(const std::string& name) const override;
 };
 
 /**
@@ -126,7 +126,33 @@ public:
     void printSize() const;
     std::string sizeToString() const;
 
-    std::string surroundName(const std::string& name) override;
+    std::string surroundName(const std::string& name) const override;
+};
+
+/**
+ * @brief The VectorType class represents vector of the GCC vector extension.
+ * It is always written as a typedef, the definition is printed by the Writer.
+ */
+class VectorType : public Type {
+public:
+    std::unique_ptr<Type> type; //type of the elements
+    unsigned size; //number of elements
+    unsigned bytes; //size of the vector in bytes
+    unsigned align; //alignment if it is lower than the natural one, 0 otherwise
+    std::string name; //name of the typedef
+
+    VectorType(std::unique_ptr<Type>, unsigned, unsigned, unsigned, const std::string&);
+    VectorType(const VectorType&);
+
+    std::unique_ptr<Type> clone() const override;
+    void print() const override;
+    std::string toString() const override;
+
+    /**
+     * @brief attributesToString Returns the attributes that make the typedef a vector.
+     * @return String containing __attribute__ with vector_size (and aligned)
+     */
+    std::string attributesToString() const;
 };
 
 /**
@@ -1,11 +1,15 @@
 #include "TypeHandler.h"
 
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/Support/MathExtras.h"
 
 #include "../core/Program.h"
 
 #include <boost/lambda/lambda.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
 std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
     if (typeDefs.find(type) != typeDefs.end()) {
         return typeDefs[type]->clone();
@@ -15,6 +19,32 @@ std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
         return std::make_unique<ArrayType>(getType(type->getArrayElementType()), type->getArrayNumElements());
     }
 
+    if (type->isVectorTy()) {
+        const auto* vectorType = llvm::cast<llvm::VectorType>(type);
+        const auto* elementType = vectorType->getElementType();
+        unsigned size = vectorType->getNumElements();
+
+        // GCC only allows vectors of integers and floats whose size is a power of two
+        if ((size & (size - 1)) != 0) {
+            throw std::invalid_argument("Vectors with number of elements other than power of two are not supported!");
+        }
+
+        unsigned elementBytes;
+        std::unique_ptr<Type> element;
+        if (elementType->isIntegerTy(1)) {
+            // vector comparisons give masks of 0 and -1, so vectors of i1 are kept in signed chars
+            elementBytes = 1;
+            element = std::make_unique<CharType>(false);
+        } else if (elementType->isIntegerTy() || elementType->isFloatTy() || elementType->isDoubleTy()) {
+            element = getType(elementType);
+            elementBytes = std::max<uint64_t>(8, llvm::PowerOf2Ceil(elementType->getPrimitiveSizeInBits())) / 8;
+        } else {
+            throw std::invalid_argument("Only vectors of integers, floats and doubles are supported!");
+        }
+
+        return getVectorType(*element, size, size * elementBytes);
+    }
+
     if (type->isVoidTy()) {
         return std::make_unique<VoidType>();
     }
@@ -130,7 +160,66 @@ std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
     return nullptr;
 }
 
+std::unique_ptr<Type> TypeHandler::getVectorType(const Type& elementType, unsigned size, unsigned bytes, unsigned align) {
+    // the name describes the vector, so that the same vector always gets the same typedef
+    std::string element = elementType.toString();
+    if (element.compare(0, 9, "unsigned ") == 0) {
+        element = "u" + element.substr(9);
+    }
+    std::replace(element.begin(), element.end(), ' ', '_');
+
+    std::string name = "vec" + std::to_string(size) + "_" + element;
+    if (align != 0) {
+        name += "_a" + std::to_string(align);
+    }
+
+    auto it = vectorTypeDefs.find(name);
+    if (it == vectorTypeDefs.end()) {
+        it = vectorTypeDefs.emplace(name, std::make_unique<VectorType>(elementType.clone(), size, bytes, align, name)).first;
+        sortedVectorTypeDefs.push_back(it->second.get());
+    }
+
+    return it->second->clone();
+}
+
+std::unique_ptr<Type> TypeHandler::getVectorType(const VectorType& vector, bool unsignedType) {
+    auto element = vector.type->clone();
+    static_cast<IntegerType*>(element.get())->unsignedType = unsignedType;
+
+    return getVectorType(*element, vector.size, vector.bytes, vector.align);
+}
+
+std::unique_ptr<Type> TypeHandler::getMaskType(const VectorType& vector) {
+    std::unique_ptr<Type> element;
+    switch (vector.bytes / vector.size) {
+    case 1:
+        element = std::make_unique<CharType>(false);
+        break;
+    case 2:
+        element = std::make_unique<ShortType>(false);
+        break;
+    case 4:
+        element = std::make_unique<IntType>(false);
+        break;
+    case 8:
+        element = std::make_unique<LongType>(false);
+        break;
+    default:
+        element = std::make_unique<Int128>();
+        break;
+    }
+
+    return getVectorType(*element, vector.size, vector.bytes);
+}
+
 std::unique_ptr<Type> TypeHandler::getBinaryType(const Type* left, const Type* right) {
+    if (dynamic_cast<const VectorType*>(left)) {
+        return left->clone();
+    }
+    if (dynamic_cast<const VectorType*>(right)) {
+        return right->clone();
+    }
+
     if (const auto LDT = dynamic_cast<const LongDoubleType*>(left)) {
         return std::make_unique<LongDoubleType>();
     }
@@ -209,3 +298,11 @@ std::string TypeHandler::getStructName(const std::string& structName) {
 
     return name;
 }
+
+unsigned TypeHandler::getOverAlignment(llvm::Type* type, unsigned align, const llvm::DataLayout& layout) {
+    if (!type->isSized() || align <= layout.getABITypeAlignment(type)) {
+        return 0;
+    }
+
+    return align;
+}
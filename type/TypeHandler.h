@@ -7,6 +7,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include <llvm/IR/Module.h>
 
+#include <map>
 #include <memory>
 
 class Program;
@@ -16,6 +17,8 @@ private:
     Program* program;
     llvm::DenseMap<const llvm::Type*, std::unique_ptr<Type>> typeDefs; //map containing typedefs
 
+    std::map<std::string, std::unique_ptr<VectorType>> vectorTypeDefs; //map containing vector typedefs by their name
+
     unsigned typeDefCount = 0; //variable used for creating new name for typedef
 
     /**
@@ -30,6 +33,7 @@ private:
 
 public:
     std::vector<const FunctionPointerType*> sortedTypeDefs; //vector of sorted typedefs, used in output
+    std::vector<const VectorType*> sortedVectorTypeDefs; //vector typedefs in order of creation, printed before other typedefs
 
     TypeHandler(Program* program)
         : program(program) { }
@@ -41,6 +45,32 @@ public:
      */
     std::unique_ptr<Type> getType(const llvm::Type* type);
 
+    /**
+     * @brief getVectorType Returns the vector typedef with the given properties, the typedef is created if it does not exist yet.
+     * @param elementType type of the elements
+     * @param size number of elements
+     * @param bytes size of the vector in bytes
+     * @param align alignment lower than the natural one (used for unaligned memory accesses), 0 otherwise
+     * @return unique_ptr to VectorType object
+     */
+    std::unique_ptr<Type> getVectorType(const Type& elementType, unsigned size, unsigned bytes, unsigned align = 0);
+
+    /**
+     * @brief getVectorType Returns the vector type with elements of the given signedness.
+     * @param vector vector type, its elements have to be integers
+     * @param unsignedType whether the elements should be unsigned
+     * @return unique_ptr to VectorType object
+     */
+    std::unique_ptr<Type> getVectorType(const VectorType& vector, bool unsignedType);
+
+    /**
+     * @brief getMaskType Returns vector of signed integers of the same size as elements of the given vector.
+     * Such vectors are results of comparisons and can be used to select elements by bitwise operations.
+     * @param vector vector type
+     * @return unique_ptr to VectorType object
+     */
+    std::unique_ptr<Type> getMaskType(const VectorType& vector);
+
     /**
      * @brief getBinaryType Returns type that would be result of a binary operation
      * @param left left argument of the operation
@@ -56,11 +86,20 @@ public:
      */
     static std::string getStructName(const std::string& structName);
 
+    /**
+     * @brief getOverAlignment Returns alignment of a memory object or access if it is higher than the ABI alignment of its type.
+     * @param type LLVM type of the object or of the accessed value
+     * @param align alignment given in LLVM
+     * @param layout data layout of the module
+     * @return align if it is higher than the natural alignment of type, 0 otherwise
+     */
+    static unsigned getOverAlignment(llvm::Type* type, unsigned align, const llvm::DataLayout& layout);
+
     /**
      * @brief hasTypeDefs Returns whether the program has any typedefs.
      * @return True if program has typedefs, false otherwise
      */
     bool hasTypeDefs() const {
-        return !typeDefs.empty();
+        return !typeDefs.empty() || !vectorTypeDefs.empty();
     }
 };
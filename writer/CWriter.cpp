@@ -35,6 +35,10 @@ void CWriter::defineType(StrRef ty, StrRef alias, StrRef end) {
     out << "typedef " << ty << " " << alias << end << ";" << std::endl;
 }
 
+void CWriter::functionAttributes(StrRef attributes) {
+    out << "__attribute__((" << attributes << ")) ";
+}
+
 void CWriter::startFunction(StrRef ret, StrRef name) {
     out << ret << " " << name;
 }
@@ -92,6 +96,10 @@ void CWriter::declareVar(StrRef ty, StrRef name) {
     out << ty << " " << name << ";" << std::endl;
 }
 
+void CWriter::assumeAligned(StrRef name, unsigned alignment) {
+    out << name << " = __builtin_assume_aligned(" << name << ", " << alignment << ");" << std::endl;
+}
+
 void CWriter::startBlock(StrRef label) {
     out << label << ": ;" << std::endl;
 }
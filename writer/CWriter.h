@@ -21,6 +21,7 @@ public:
     void indent(size_t tabs);
     void structItem(StrRef ty, StrRef name);
     void defineType(StrRef ty, StrRef alias, StrRef end);
+    void functionAttributes(StrRef attributes);
     void startFunction(StrRef ret, StrRef name);
     void startArrayFunction(StrRef ret, size_t levels, StrRef name);
     void endFunctionDecl();
@@ -39,5 +40,6 @@ public:
     void startFunctionBody();
     void endFunctionBody();
     void declareVar(StrRef ty, StrRef name);
+    void assumeAligned(StrRef name, unsigned alignment);
     void startBlock(StrRef label);
 };
@@ -2,6 +2,10 @@
 
 #include "../core/Block.h"
 
+#include <cstdint>
+#include <map>
+#include <sstream>
+
 ExprWriter::ExprWriter(std::ostream& os, bool noFuncCasts): ss(os), noFuncCasts(noFuncCasts) { }
 
 void ExprWriter::visit(Struct& expr) {
@@ -82,17 +86,48 @@ void ExprWriter::visit(GlobalValue& expr) {
 }
 
 void ExprWriter::visit(IfExpr& expr) {
-    if (expr.cmp) {
-        ss << "if (";
-        expr.cmp->accept(*this);
-        ss << ") {" << std::endl;
-        gotoOrInline(expr.trueBlock);
+    if (!expr.cmp) {
+        edge(expr.trueBlock, expr.trueJump, expr.trueCopies);
+        return;
+    }
+
+    bool trueEmpty = expr.trueJump == JumpKind::NONE && expr.trueCopies.empty();
+    bool falseEmpty = expr.falseJump == JumpKind::NONE && expr.falseCopies.empty();
+
+    if (trueEmpty) {
+        if (!falseEmpty) {
+            ss << "if (";
+            negation(expr.cmp);
+            ss << ") {" << std::endl;
+            edge(expr.falseBlock, expr.falseJump, expr.falseCopies);
+            ss << "    }" << std::endl;
+        }
+        return;
+    }
+
+    ss << "if (";
+    expr.cmp->accept(*this);
+    ss << ") {" << std::endl;
+    edge(expr.trueBlock, expr.trueJump, expr.trueCopies);
+    if (!falseEmpty) {
         ss << "    } else {" << std::endl;
-        gotoOrInline(expr.falseBlock);
-        ss << "    }" << std::endl;
-    } else {
-        gotoOrInline(expr.trueBlock);
+        edge(expr.falseBlock, expr.falseJump, expr.falseCopies);
     }
+    ss << "    }" << std::endl;
+}
+
+// case value in the signedness of the switched expression, e.g. 255u for -1 of i8 compared as unsigned
+static std::string caseValue(int64_t value, unsigned bitWidth, bool isUnsigned) {
+    if (isUnsigned) {
+        uint64_t unsignedValue = bitWidth < 64 ? static_cast<uint64_t>(value) & ((1ull << bitWidth) - 1) : static_cast<uint64_t>(value);
+        return std::to_string(unsignedValue) + (bitWidth > 32 ? "ull" : "u");
+    }
+
+    // the literal of the minimum would be the negation of an unrepresentable value
+    if (value == INT64_MIN) {
+        return "(-9223372036854775807ll - 1)";
+    }
+    return std::to_string(value) + (bitWidth > 32 ? "ll" : "");
 }
 
 void ExprWriter::visit(SwitchExpr& expr) {
@@ -100,17 +135,38 @@ void ExprWriter::visit(SwitchExpr& expr) {
     expr.cmp->accept(*this);
     ss << ") {" << std::endl;
 
-    for (const auto& lb_block : expr.cases) {
-        const auto& label = lb_block.first;
-        const auto& block = lb_block.second;
+    auto IT = dynamic_cast<IntegerType*>(expr.cmp->getType());
+    bool isUnsigned = IT && IT->unsignedType;
 
-        ss << "    case " << label << ": ";
-        gotoOrInline(block);
+    // consecutive values with the same target become GNU case ranges
+    std::map<const Block*, std::vector<std::pair<int64_t, int64_t>>> ranges;
+    for (const auto& lb_block : expr.cases) {
+        auto& blockRanges = ranges[lb_block.second];
+        // compared as unsigned, -1 is the maximum and 0 the minimum
+        if (!blockRanges.empty() && lb_block.first - 1 == blockRanges.back().second && !(isUnsigned && lb_block.first == 0)) {
+            blockRanges.back().second = lb_block.first;
+        } else {
+            blockRanges.emplace_back(lb_block.first, lb_block.first);
+        }
     }
 
-    if (expr.def) {
-        ss << "    default:" << std::endl;
-        gotoOrInline(expr.def);
+    for (auto* block : expr.targets()) {
+        for (const auto& range : ranges[block]) {
+            ss << "    case " << caseValue(range.first, expr.bitWidth, isUnsigned);
+            if (range.second != range.first) {
+                ss << " ... " << caseValue(range.second, expr.bitWidth, isUnsigned);
+            }
+            ss << ":" << std::endl;
+        }
+
+        if (block == expr.def) {
+            ss << "    default:" << std::endl;
+        }
+
+        auto jumpIt = expr.jumps.find(block);
+        auto copiesIt = expr.copies.find(block);
+        edge(block, jumpIt == expr.jumps.end() ? JumpKind::GOTO : jumpIt->second,
+                copiesIt == expr.copies.end() ? std::vector<Expr*>() : copiesIt->second);
     }
 
     ss << "}" << std::endl;
@@ -256,6 +312,11 @@ void ExprWriter::visit(DerefExpr& deref) {
 }
 
 void ExprWriter::visit(RetExpr& ret) {
+    auto call = dynamic_cast<CallExpr*>(ret.expr);
+    if (call && call->isMustTail) {
+        ss << "LLVM2C_MUSTTAIL ";
+    }
+
     ss << "return";
     if (ret.expr) {
         ss << " ";
@@ -263,6 +324,11 @@ void ExprWriter::visit(RetExpr& ret) {
     }
 }
 
+void ExprWriter::visit(IndirectGotoExpr& expr) {
+    ss << "goto *";
+    parensIfNotSimple(expr.expr);
+}
+
 void ExprWriter::visit(CastExpr& cast) {
     ss << "(" << cast.getType()->toString();
     if (auto PT = dynamic_cast<const PointerType*>(cast.getType())) {
@@ -347,8 +413,8 @@ void ExprWriter::visit(AshrExpr& expr) {
 }
 
 void ExprWriter::visit(LshrExpr& expr) {
-    auto IT = static_cast<IntegerType*>(expr.left->getType());
-    if (!IT->unsignedType) {
+    auto IT = dynamic_cast<IntegerType*>(expr.left->getType());
+    if (IT && !IT->unsignedType) {
         ss << "(unsigned " << IT->toString() << ")(";
     } else {
         ss << "(";
@@ -365,23 +431,243 @@ void ExprWriter::visit(ShlExpr& expr) {
     parensIfNotSimple(expr.right);
 }
 
+void ExprWriter::visit(ScopeExpr& expr) {
+    ss << (expr.isOpening ? "{" : "}") << std::endl;
+}
+
 void ExprWriter::visit(StackAlloc& expr) {
-    ss << expr.getType()->toString();
-    ss << " ";
-    ss << expr.getType()->surroundName(expr.value->valueName);
-}
-
-void ExprWriter::gotoOrInline(Block* block) {
-    if (block->doInline) {
-        ss << "{ // " << block->blockName << std::endl;
-        for (const auto& expr : block->expressions) {
-            ss << "    ";
-            expr->accept(*this);
-            ss << ";" << std::endl;
+    if (expr.count) {
+        // the array decays to the pointer to its first element
+        const auto* element = static_cast<const PointerType*>(expr.getType())->type.get();
+        std::stringstream count;
+        ExprWriter countWriter(count, noFuncCasts);
+        expr.count->accept(countWriter);
+
+        ss << element->toString();
+        ss << " ";
+        ss << element->surroundName(expr.value->valueName + "[" + count.str() + "]");
+    } else {
+        ss << expr.getType()->toString();
+        ss << " ";
+        ss << expr.getType()->surroundName(expr.value->valueName);
+    }
+    if (expr.alignment) {
+        ss << " __attribute__((aligned(" << expr.alignment << ")))";
+    }
+}
+
+void ExprWriter::visit(InsertElementExpr& expr) {
+    // the element is set in a copy, the original vector may still be used
+    ss << "({ " << expr.getType()->toString() << " __vec = ";
+    expr.vector->accept(*this);
+    ss << "; __vec[";
+    expr.index->accept(*this);
+    ss << "] = ";
+    expr.element->accept(*this);
+    ss << "; __vec; })";
+}
+
+void ExprWriter::visit(ShuffleVectorExpr& expr) {
+    ss << "__builtin_shufflevector(";
+    expr.left->accept(*this);
+    ss << ", ";
+    expr.right->accept(*this);
+    for (int index : expr.mask) {
+        ss << ", " << index;
+    }
+    ss << ")";
+}
+
+void ExprWriter::visit(ConvertVectorExpr& expr) {
+    ss << "__builtin_convertvector(";
+    expr.expr->accept(*this);
+    ss << ", " << expr.getType()->toString() << ")";
+}
+
+void ExprWriter::visit(AtomicRMWExpr& expr) {
+    std::string type = expr.getType()->toString();
+    std::string update;
+
+    switch (expr.op) {
+    case AtomicRMWExpr::Op::XCHG:
+        update = "__val";
+        break;
+    case AtomicRMWExpr::Op::MAX:
+        update = "__old > __val ? __old : __val";
+        break;
+    case AtomicRMWExpr::Op::MIN:
+        update = "__old < __val ? __old : __val";
+        break;
+    case AtomicRMWExpr::Op::FADD:
+        update = "__old + __val";
+        break;
+    case AtomicRMWExpr::Op::FSUB:
+        update = "__old - __val";
+        break;
+    }
+
+    ss << "({ " << type << "* __ptr = ";
+    expr.pointer->accept(*this);
+    ss << "; " << type << " __val = ";
+    expr.value->accept(*this);
+    ss << "; " << type << " __old, __new; __atomic_load(__ptr, &__old, __ATOMIC_RELAXED); ";
+    ss << "do { __new = " << update << "; } ";
+    ss << "while (!__atomic_compare_exchange(__ptr, &__old, &__new, 1, " << expr.order << ", __ATOMIC_RELAXED)); __old; })";
+}
+
+void ExprWriter::visit(VectorReduceExpr& expr) {
+    std::string type = expr.getType()->toString();
+    std::string update;
+    if (!expr.builtin.empty()) {
+        update = expr.builtin + "(__acc, __elem)";
+    } else if (expr.op == "<" || expr.op == ">") {
+        update = "__elem " + expr.op + " __acc ? __elem : __acc";
+    } else {
+        update = "__acc " + expr.op + " __elem";
+    }
+
+    // elements are converted to the type of the result, which has the signedness of the operation
+    ss << "({ " << expr.vector->getType()->toString() << " __vec = ";
+    expr.vector->accept(*this);
+    ss << "; " << type << " __acc = ";
+    if (expr.start) {
+        expr.start->accept(*this);
+    } else {
+        ss << "__vec[0]";
+    }
+    ss << "; for (unsigned __i = " << (expr.start ? 0 : 1) << "; __i < " << expr.size << "; __i++) { ";
+    ss << type << " __elem = __vec[__i]; __acc = " << update << "; } __acc; })";
+}
+
+void ExprWriter::writeBlock(const Block* block) {
+    if (block->hasLabel) {
+        ss << block->blockName << ": ;" << std::endl;
+    }
+
+    if (!block->isLoopHeader) {
+        writeContent(block);
+        return;
+    }
+
+    for (const auto& pragma : block->getTables().loopPragmas) {
+        ss << pragma << std::endl;
+    }
+
+    const auto& exprs = block->expressions;
+    auto* cond = exprs.empty() ? nullptr : dynamic_cast<IfExpr*>(exprs.back());
+    if (cond && !cond->cmp) {
+        cond = nullptr;
+    }
+
+    bool breakOnTrue = cond && cond->trueJump == JumpKind::BREAK && cond->trueCopies.empty();
+    bool breakOnFalse = cond && cond->falseJump == JumpKind::BREAK && cond->falseCopies.empty();
+
+    if (cond && exprs.size() == 1 && (breakOnTrue || breakOnFalse)) {
+        // the header only decides whether to leave the loop
+        bool exitOnTrue = breakOnTrue;
+        ss << "    while (";
+        if (exitOnTrue) {
+            negation(cond->cmp);
+        } else {
+            cond->cmp->accept(*this);
+        }
+        ss << ") {" << std::endl;
+        if (exitOnTrue) {
+            edge(cond->falseBlock, cond->falseJump, cond->falseCopies);
+        } else {
+            edge(cond->trueBlock, cond->trueJump, cond->trueCopies);
+        }
+        for (const auto* follower : block->followers) {
+            writeBlock(follower);
         }
-        ss << "}" << std::endl;
+        ss << "    }" << std::endl;
+    } else if (cond && block->followers.empty() && cond->trueCopies.empty() && cond->falseCopies.empty()
+            && ((cond->trueBlock == block && cond->trueJump == JumpKind::NONE && breakOnFalse)
+                || (cond->falseBlock == block && cond->falseJump == JumpKind::NONE && breakOnTrue))) {
+        // the loop consists of this block only, it decides whether to repeat at its end
+        ss << "    do {" << std::endl;
+        for (auto it = exprs.begin(); it + 1 != exprs.end(); ++it) {
+            writeStatement(*it);
+        }
+        ss << "    } while (";
+        if (cond->trueBlock == block) {
+            cond->cmp->accept(*this);
+        } else {
+            negation(cond->cmp);
+        }
+        ss << ");" << std::endl;
+    } else {
+        ss << "    while (1) {" << std::endl;
+        writeContent(block);
+        ss << "    }" << std::endl;
+    }
+
+    for (const auto* exit : block->loopExits) {
+        writeBlock(exit);
+    }
+}
+
+void ExprWriter::writeStatement(Expr* expr) {
+    // unconditional branch writes its own lines
+    auto ifExpr = dynamic_cast<IfExpr*>(expr);
+    if (!ifExpr || ifExpr->cmp) {
+        ss << "    ";
+    }
+    expr->accept(*this);
+
+    // if, switch and scope end with their own braces or jumps
+    if (!dynamic_cast<IfExpr*>(expr) && !dynamic_cast<SwitchExpr*>(expr) && !dynamic_cast<ScopeExpr*>(expr)) {
+        ss << ";" << std::endl;
+    }
+}
+
+void ExprWriter::writeContent(const Block* block) {
+    for (const auto& expr : block->expressions) {
+        writeStatement(expr);
+    }
+
+    for (const auto* follower : block->followers) {
+        writeBlock(follower);
+    }
+}
+
+void ExprWriter::edge(const Block* block, JumpKind kind, const std::vector<Expr*>& copies) {
+    for (auto copy : copies) {
+        writeStatement(copy);
+    }
+
+    jump(block, kind);
+}
+
+void ExprWriter::jump(const Block* block, JumpKind kind) {
+    switch (kind) {
+    case JumpKind::INLINE:
+        ss << "    { // " << block->blockName << std::endl;
+        writeBlock(block);
+        ss << "    }" << std::endl;
+        break;
+    case JumpKind::NONE:
+        break;
+    case JumpKind::BREAK:
+        ss << "    break;" << std::endl;
+        break;
+    case JumpKind::CONTINUE:
+        ss << "    continue;" << std::endl;
+        break;
+    case JumpKind::GOTO:
+        ss << "    goto " << block->blockName << ";" << std::endl;
+        break;
+    }
+}
+
+void ExprWriter::negation(Expr* expr) {
+    ss << "!";
+    if (expr->isSimple()) {
+        expr->accept(*this);
     } else {
-        ss << "goto " << block->blockName << ";" << std::endl;
+        ss << "(";
+        expr->accept(*this);
+        ss << ")";
     }
 }
 
@@ -14,18 +14,29 @@ private:
     std::ostream& ss;
     bool noFuncCasts;
 
-    void gotoOrInline(Block* block);
+    void writeStatement(Expr* expr);
+    void writeContent(const Block* block);
+    void edge(const Block* block, JumpKind kind, const std::vector<Expr*>& copies);
+    void jump(const Block* block, JumpKind kind);
+    void negation(Expr* expr);
     void parensIfNotSimple(Expr* expr);
 
 public:
     ExprWriter(std::ostream& os, bool noFuncCasts);
 
+    /**
+     * @brief writeBlock Writes the block together with all blocks that are structured into it.
+     * @param block Block to write
+     */
+    void writeBlock(const Block* block);
+
     void visit(Struct& expr) override;
     void visit(StructElement& expr) override;
     void visit(ArrayElement& expr) override;
     void visit(ExtractValueExpr& expr) override;
     void visit(Value& expr) override;
     void visit(GlobalValue& expr) override;
+    void visit(ScopeExpr& expr) override;
     void visit(IfExpr& expr) override;
     void visit(SwitchExpr& expr) override;
     void visit(AsmExpr& expr) override;
@@ -36,6 +47,7 @@ public:
     void visit(RefExpr& expr) override;
     void visit(DerefExpr& expr) override;
     void visit(RetExpr& expr) override;
+    void visit(IndirectGotoExpr& expr) override;
     void visit(CastExpr& expr) override;
     void visit(AddExpr& expr) override;
     void visit(SubExpr& expr) override;
@@ -51,6 +63,11 @@ public:
     void visit(LshrExpr& expr) override;
     void visit(ShlExpr& expr) override;
     void visit(StackAlloc& expr) override;
+    void visit(InsertElementExpr& expr) override;
+    void visit(ShuffleVectorExpr& expr) override;
+    void visit(ConvertVectorExpr& expr) override;
+    void visit(AtomicRMWExpr& expr) override;
+    void visit(VectorReduceExpr& expr) override;
 
     virtual ~ExprWriter() = default;
 };
@@ -6,6 +6,7 @@
 void Writer::writeProgram(const Program& program) {
     includes(program);
     wr.line("");
+    macros(program);
     structDeclarations(program);
     wr.line("");
     typedefs(program);
@@ -47,6 +48,22 @@ void Writer::includes(const Program& program) {
         wr.include("pthread.h");
 }
 
+void Writer::macros(const Program& program) {
+    if (!program.hasMustTail)
+        return;
+
+    // musttail is not known to every compiler
+    wr.line("#if defined(__has_attribute)");
+    wr.line("#if __has_attribute(musttail)");
+    wr.line("#define LLVM2C_MUSTTAIL __attribute__((musttail))");
+    wr.line("#endif");
+    wr.line("#endif");
+    wr.line("#ifndef LLVM2C_MUSTTAIL");
+    wr.line("#define LLVM2C_MUSTTAIL");
+    wr.line("#endif");
+    wr.line("");
+}
+
 void Writer::structDeclarations(const Program& program) {
     wr.comment("struct declarations");
     const auto& structs = program.structs;
@@ -104,6 +121,11 @@ void Writer::structDefinitions(const Program& program) {
 
 void Writer::typedefs(const Program& program) {
     wr.comment("type definitions");
+    // vectors go first, other typedefs may use them
+    for (const auto& def : program.typeHandler.sortedVectorTypeDefs) {
+        wr.defineType(def->type->toString(), def->name, def->attributesToString());
+    }
+
     const auto& defs = program.typeHandler.sortedTypeDefs;
 
     for (const auto& def : defs) {
@@ -120,6 +142,14 @@ void Writer::anonymousStructDeclarations(const Program& program) {
     }
 }
 
+static std::string globalVarName(const GlobalValue* gvar) {
+    std::string name = gvar->getType()->surroundName(gvar->valueName);
+    if (gvar->alignment) {
+        name += " __attribute__((aligned(" + std::to_string(gvar->alignment) + ")))";
+    }
+    return name;
+}
+
 void Writer::globalVars(const Program& program) {
     wr.comment("global variable declarations");
     for (const auto& gvar : program.globalVars) {
@@ -127,7 +157,7 @@ void Writer::globalVars(const Program& program) {
             continue;
         }
 
-        wr.declareVar(gvar->getType()->toString(), gvar->getType()->surroundName(gvar->valueName));
+        wr.declareVar(gvar->getType()->toString(), globalVarName(gvar.get()));
     }
 }
 
@@ -140,14 +170,22 @@ void Writer::globalVarDefinitions(const Program& program) {
 
         wr.raw(gvar->getType()->toString());
         wr.raw(" ");
-        wr.raw(gvar->getType()->surroundName(gvar->valueName));
+        wr.raw(globalVarName(gvar.get()));
         wr.raw(" = ");
         wr.raw(gvar->value);
         wr.line(";");
     }
 }
 
-void Writer::functionHead(const Func* func) {
+void Writer::functionHead(const FuncDecl* func) {
+    if (!func->attributes.empty()) {
+        std::string attributes;
+        for (const auto& attribute : func->attributes) {
+            attributes += (attributes.empty() ? "" : ", ") + attribute;
+        }
+        wr.functionAttributes(attributes);
+    }
+
     auto PT = dynamic_cast<PointerType*>(func->returnType.get());
     bool arrayPtr = (PT && PT->isArrayPointer);
     if (arrayPtr) {
@@ -161,6 +199,9 @@ void Writer::functionHead(const Func* func) {
     for (auto it = func->parameters.cbegin(); it != func->parameters.cend(); ++it) {
         const auto& param = *it;
         wr.raw(param->getType()->toString());
+        if (func->restrictParams.count(param)) {
+            wr.raw(" restrict");
+        }
         wr.raw(" ");
         param->accept(ew);
 
@@ -230,7 +271,7 @@ void Writer::anonymousStructDefinitions(const Program& program) {
     }
 }
 
-bool Writer::isFunctionPrinted(const Func* func) const {
+bool Writer::isFunctionPrinted(const FuncDecl* func) const {
     if (isCFunc(func->name) || func->name == "va_start" || func->name == "va_end" || func->name == "va_copy" || isCMath(func->name)) {
         return false;
     }
@@ -248,18 +289,6 @@ bool Writer::isFunctionPrinted(const Func* func) const {
     return true;
 }
 
-void Writer::writeBlock(const Block* block, bool first) {
-    if (!first) {
-        wr.startBlock(block->blockName);
-    }
-
-    for (const auto& expr : block->expressions) {
-        wr.indent(1);
-        expr->accept(ew);
-        wr.line(";");
-    }
-}
-
 void Writer::functionDefinitions(const Program& program) {
     for (const auto& pair : program.functions) {
         const auto* func = pair.second.get();
@@ -270,21 +299,26 @@ void Writer::functionDefinitions(const Program& program) {
         functionHead(func);
         wr.startFunctionBody();
 
-        // start with phi variables
-        // TODO: prepend phi variables of function to the first block instead of this hack
-        for (const auto& var : func->phiVariables) {
+        for (const auto& var : func->staticVars) {
             wr.indent(1);
-            wr.declareVar(var->getType()->toString(), var->getType()->surroundName(var->valueName));
+            wr.raw(var->getType()->toString());
+            wr.raw(" ");
+            wr.raw(globalVarName(var.get()));
+            wr.raw(" = ");
+            wr.raw(var->value);
+            wr.line(";");
         }
 
-        bool first = true;
-        for (const auto& blockEntry : func->blockMap) {
-            const auto* block = blockEntry.second.get();
-            if (!block->doInline || first)
-                writeBlock(block, first);
-            first = false;
+        for (const auto* param : func->parameters) {
+            auto it = func->alignedParams.find(param);
+            if (it != func->alignedParams.end()) {
+                wr.indent(1);
+                wr.assumeAligned(param->valueName, it->second);
+            }
         }
 
+        ew.writeBlock(func->entryBlock);
+
         wr.endFunctionBody();
     }
 }
@@ -19,6 +19,7 @@ private:
     bool noFuncCasts;
 
     void includes(const Program& program);
+    void macros(const Program& program);
     void structDeclarations(const Program& program);
     void structDefinitions(const Program& program);
     void globalVars(const Program& program);
@@ -29,9 +30,8 @@ private:
     void functionDefinitions(const Program& program);
     void typedefs(const Program& program);
     void structDefinition(const Struct* strct);
-    bool isFunctionPrinted(const Func* func) const;
-    void functionHead(const Func* func);
-    void writeBlock(const Block* block, bool first);
+    bool isFunctionPrinted(const FuncDecl* func) const;
+    void functionHead(const FuncDecl* func);
 
 
 public: